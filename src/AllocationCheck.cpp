@@ -0,0 +1,92 @@
+#include "AllocationCheck.h"
+
+#ifdef ALLOC_CHECK
+
+#include <SDL2/SDL.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> allocationCount(0);
+static std::atomic<bool> allocationsForbidden(false);
+
+static void countAllocation(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (allocationsForbidden.load(std::memory_order_relaxed)) {
+        // 報告中の確保で再び止まらないよう先に解除する
+        allocationsForbidden.store(false);
+        fprintf(stderr,
+                "ALLOC_CHECK: %lu-byte heap allocation in a steady-state "
+                "frame\n",
+                static_cast<unsigned long>(size));
+        abort();
+    }
+}
+
+// C++ 側の確保
+void* operator new(size_t size) {
+    countAllocation(size);
+    void* p = malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+
+// SDL 内部の確保
+static SDL_malloc_func sdlMalloc;
+static SDL_calloc_func sdlCalloc;
+static SDL_realloc_func sdlRealloc;
+static SDL_free_func sdlFree;
+
+static void* checkedMalloc(size_t size) {
+    countAllocation(size);
+    return sdlMalloc(size);
+}
+
+static void* checkedCalloc(size_t count, size_t size) {
+    countAllocation(count * size);
+    return sdlCalloc(count, size);
+}
+
+static void* checkedRealloc(void* p, size_t size) {
+    countAllocation(size);
+    return sdlRealloc(p, size);
+}
+
+static void checkedFree(void* p) { sdlFree(p); }
+
+void installAllocationHooks() {
+    if (sdlMalloc) {
+        return;
+    }
+    SDL_GetMemoryFunctions(&sdlMalloc, &sdlCalloc, &sdlRealloc, &sdlFree);
+    SDL_SetMemoryFunctions(checkedMalloc, checkedCalloc, checkedRealloc,
+                           checkedFree);
+}
+
+void setAllocationsForbidden(bool forbidden) {
+    allocationsForbidden.store(forbidden);
+}
+
+uint64_t getAllocationCount() { return allocationCount.load(); }
+
+bool isAllocationCheckEnabled() { return true; }
+
+#else
+
+void installAllocationHooks() {}
+
+void setAllocationsForbidden(bool) {}
+
+uint64_t getAllocationCount() { return 0; }
+
+bool isAllocationCheckEnabled() { return false; }
+
+#endif
@@ -0,0 +1,21 @@
+#pragma once
+#include <stdint.h>
+
+// 定常状態のフレームでヒープ確保が起きていないかを調べるデバッグ機能
+//
+// ALLOC_CHECK を定義したビルド（make alloccheck）でのみ有効になり、
+// グローバルな operator new と SDL のメモリ関数（SDL_SetMemoryFunctions）を
+// 差し替えて確保を数える。禁止中に確保が起きるとその場でメッセージを出して
+// abort するので、デバッガのバックトレースで確保した箇所がわかる
+// 通常のビルドではどの関数も何もしない
+
+// SDL のメモリ関数を差し替える（SDL の初期化より前に呼ぶ）
+void installAllocationHooks();
+
+// 以降の確保を禁止する／許可する（どのスレッドでの確保も対象）
+void setAllocationsForbidden(bool forbidden);
+
+// これまでの確保回数（無効なビルドでは 0）
+uint64_t getAllocationCount();
+
+bool isAllocationCheckEnabled();
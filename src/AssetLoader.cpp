@@ -0,0 +1,149 @@
+#include "AssetLoader.h"
+
+#include <cstdio>
+
+// 存在確認だけなので開いてすぐ閉じる
+static bool fileExists(const std::string& path) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    fclose(file);
+    return true;
+}
+
+AssetLoader::AssetLoader()
+    : wakeEventType(0),
+      thread(nullptr),
+      mutex(SDL_CreateMutex()),
+      jobAdded(SDL_CreateCond()),
+      jobDone(SDL_CreateCond()),
+      pending(0),
+      stopping(false) {}
+
+AssetLoader::~AssetLoader() {
+    stop();
+    SDL_DestroyCond(jobDone);
+    SDL_DestroyCond(jobAdded);
+    SDL_DestroyMutex(mutex);
+}
+
+void AssetLoader::addSearchPath(const std::string& dir) {
+    if (!dir.empty()) {
+        searchPaths.push_back(dir);
+    }
+}
+
+std::vector<std::string> AssetLoader::findFiles(
+    const std::vector<std::string>& names) const {
+    std::vector<std::string> found;
+    for (size_t n = 0; n < names.size(); n++) {
+        const std::string& name = names[n];
+        if (name.find('/') != std::string::npos ||
+            name.find('\\') != std::string::npos) {
+            if (fileExists(name)) {
+                found.push_back(name);
+            }
+            continue;
+        }
+        for (size_t d = 0; d < searchPaths.size(); d++) {
+            std::string path = searchPaths[d];
+            char last = path[path.size() - 1];
+            if (last != '/' && last != '\\') {
+                path += '/';
+            }
+            path += name;
+            if (fileExists(path)) {
+                found.push_back(path);
+            }
+        }
+    }
+    return found;
+}
+
+bool AssetLoader::start(Uint32 wakeEventType) {
+    if (thread) {
+        return true;
+    }
+    this->wakeEventType = wakeEventType;
+    stopping = false;
+    thread = SDL_CreateThread(threadMain, "assets", this);
+    if (!thread) {
+        SDL_Log("SDL_CreateThread Error: %s", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+void AssetLoader::enqueue(const Job& job) {
+    SDL_LockMutex(mutex);
+    jobs.push_back(job);
+    pending++;
+    SDL_CondSignal(jobAdded);
+    SDL_UnlockMutex(mutex);
+}
+
+void AssetLoader::waitIdle() {
+    SDL_LockMutex(mutex);
+    while (pending > 0 && thread) {
+        SDL_CondWait(jobDone, mutex);
+    }
+    SDL_UnlockMutex(mutex);
+}
+
+void AssetLoader::stop() {
+    if (!thread) {
+        return;
+    }
+    SDL_LockMutex(mutex);
+    stopping = true;
+    pending -= static_cast<int>(jobs.size());
+    jobs.clear();
+    SDL_CondSignal(jobAdded);
+    SDL_UnlockMutex(mutex);
+
+    SDL_WaitThread(thread, nullptr);
+    thread = nullptr;
+}
+
+int AssetLoader::getPendingCount() const {
+    SDL_LockMutex(mutex);
+    int count = pending;
+    SDL_UnlockMutex(mutex);
+    return count;
+}
+
+int AssetLoader::threadMain(void* data) {
+    static_cast<AssetLoader*>(data)->run();
+    return 0;
+}
+
+void AssetLoader::run() {
+    SDL_LockMutex(mutex);
+    for (;;) {
+        while (jobs.empty() && !stopping) {
+            SDL_CondWait(jobAdded, mutex);
+        }
+        if (stopping) {
+            break;
+        }
+        Job job = jobs.front();
+        jobs.erase(jobs.begin());
+        SDL_UnlockMutex(mutex);
+
+        job();
+
+        // メインスレッドを起こす（イベント待ちで眠っている場合がある）
+        if (wakeEventType != 0) {
+            SDL_Event event;
+            SDL_zero(event);
+            event.type = wakeEventType;
+            SDL_PushEvent(&event);
+        }
+
+        SDL_LockMutex(mutex);
+        pending--;
+        SDL_CondBroadcast(jobDone);
+    }
+    SDL_UnlockMutex(mutex);
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// ファイル読み込みなどの重い処理を1本の読み込みスレッドで順に実行する
+//
+// フォント・テクスチャ・音声などの読み込みを job として積み、メインスレッドは
+// ウィンドウ作成や最初のフレームの描画を先に進める。job が終わるたびに
+// SDL のユーザーイベントを送るので、イベント待ちで眠っていても起きられる
+// レンダラーを使う処理（テクスチャ作成など）は job の結果を受け取った
+// メインスレッド側で行う
+class AssetLoader {
+   public:
+    typedef std::function<void()> Job;
+
+    AssetLoader();
+    ~AssetLoader();
+
+    // 探すディレクトリを追加する（追加した順に探す）
+    // start() より前に設定する
+    void addSearchPath(const std::string& dir);
+
+    // names（優先順の候補）のうち存在するファイルのパスを優先順に返す
+    // 区切り文字を含む名前はそのままのパスとしても試す
+    std::vector<std::string> findFiles(
+        const std::vector<std::string>& names) const;
+
+    // 読み込みスレッドを開始する
+    // job が終わるたびに wakeEventType のイベントを送る（0 なら送らない）
+    bool start(Uint32 wakeEventType);
+
+    // job を積む（start の前後どちらでもよい）
+    void enqueue(const Job& job);
+
+    // 積んだ job がすべて終わるまで待つ（ツールなどメインループ外で使う）
+    void waitIdle();
+
+    // 残りの job を捨ててスレッドを止める
+    void stop();
+
+    // 実行待ち・実行中の job の数
+    int getPendingCount() const;
+
+   private:
+    static int threadMain(void* data);
+    void run();
+
+    std::vector<std::string> searchPaths;
+    Uint32 wakeEventType;
+
+    SDL_Thread* thread;
+    SDL_mutex* mutex;
+    SDL_cond* jobAdded;
+    SDL_cond* jobDone;
+    std::vector<Job> jobs;
+    int pending;
+    bool stopping;
+};
@@ -1,17 +1,15 @@
 #pragma once
 #include <SDL2/SDL.h>
 
-// ウィンドウサイズ・壁の厚さなどの定数
-const int WINDOW_WIDTH = 800;
-const int WINDOW_HEIGHT = 600;
-const int WALL_THICKNESS = 50;
+#include "core/Rules.h"
 
-// ゲームタイマー初期値（秒）
-const float INITIAL_MAX_TIME = 3.0f;
-const float MIN_MAX_TIME = 1.5f;
+// フォントサイズ（ポイント）
+const int FONT_SIZE = 24;
+// カウントダウンの数字のフォントサイズ（ポイント）
+const int COUNTDOWN_FONT_SIZE = 96;
 
-// プレイヤー移動のアニメーション時間（ミリ秒）
-const Uint32 MOVE_DURATION = 300;  // 0.3秒
+// カウントダウンの1段階（3, 2, 1, Go!）を表示する時間（ミリ秒）
+const Uint32 COUNTDOWN_STEP_TIME = 1000;
 
 // ゲージ（タイマー）表示のサイズ
 const int GAUGE_WIDTH = 150;
@@ -27,17 +25,15 @@ const SDL_Rect GAUGE_RECT = {20, 20, GAUGE_WIDTH, GAUGE_HEIGHT};
 const int SCORE_POS_X = WINDOW_WIDTH / 2;
 const int SCORE_POS_Y = 30;
 
-// プレイヤーのサイズ（半径）
-const int PLAYER_RADIUS = 15;
-
 // 点滅間隔（ミリ秒）
 const Uint32 BLINK_INTERVAL = 200;
 
-// ゲーム状態
-enum GameState { STATE_COUNTDOWN, STATE_PLAYING, STATE_MOVING, STATE_GAMEOVER };
-
-// 移動方向
-enum Direction { DIR_NONE, DIR_UP, DIR_DOWN, DIR_LEFT, DIR_RIGHT };
+// 省電力のフレーム間隔（ミリ秒）
+// アニメーション中（VSyncなし）の描画間隔
+const Uint32 ANIMATION_FRAME_INTERVAL = 16;
+// 画面に変化が無いときに眠る最大時間
+// （経過時間の上限 250ms より短くし、ゲーム内の時間を失わない）
+const Uint32 MAX_IDLE_WAIT = 200;
 
 // 色の定義（extern宣言）
 extern SDL_Color RED;
@@ -46,4 +42,4 @@ extern SDL_Color YELLOW;
 extern SDL_Color GREEN;
 extern SDL_Color WHITE;
 extern SDL_Color BLACK;
-extern const SDL_Color colorSet[4];
\ No newline at end of file
+extern const SDL_Color colorSet[COLOR_COUNT];
\ No newline at end of file
@@ -9,4 +9,5 @@ SDL_Color WHITE = {255, 255, 255, 255};
 SDL_Color BLACK = {0, 0, 0, 255};
 
 // 配列にまとめるとランダム選択が楽
-const SDL_Color colorSet[4] = {RED, BLUE, YELLOW, GREEN};
\ No newline at end of file
+// シミュレーション側は色をこのインデックス（0〜COLOR_COUNT-1）で扱う
+const SDL_Color colorSet[COLOR_COUNT] = {RED, BLUE, YELLOW, GREEN};
\ No newline at end of file
@@ -0,0 +1,260 @@
+#include "FrameCapture.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "PpmImage.h"
+#include "ProfileZones.h"
+
+// RGB のバイト列の FNV-1a（64ビット）
+static Uint64 hashRgb(const std::vector<Uint8>& rgb) {
+    Uint64 hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < rgb.size(); i++) {
+        hash = (hash ^ rgb[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+static std::string joinPath(const std::string& dir, const char* name) {
+    std::string path = dir;
+    char last = path[path.size() - 1];
+    if (last != '/' && last != '\\') {
+        path += '/';
+    }
+    return path + name;
+}
+
+FrameCapture::FrameCapture()
+    : width(0),
+      height(0),
+      nextTick(0),
+      frameOpen(false),
+      thread(nullptr),
+      mutex(SDL_CreateMutex()),
+      frameReady(SDL_CreateCond()),
+      head(0),
+      tail(0),
+      filled(0),
+      stopping(false),
+      hashFile(nullptr),
+      captured(0),
+      skipped(0),
+      mismatched(0),
+      missing(0) {}
+
+FrameCapture::~FrameCapture() {
+    stop();
+    SDL_DestroyCond(frameReady);
+    SDL_DestroyMutex(mutex);
+}
+
+bool FrameCapture::start(const FrameCaptureConfig& config, int width,
+                         int height) {
+    if (thread || !config.isEnabled()) {
+        return false;
+    }
+    this->config = config;
+    if (this->config.intervalTicks < 1) {
+        this->config.intervalTicks = 1;
+    }
+    this->width = width;
+    this->height = height;
+
+    // バッファは最初に確保し、取り込み中は確保しない
+    size_t pixelCount = static_cast<size_t>(width) * height;
+    for (int i = 0; i < FRAME_CAPTURE_SLOTS; i++) {
+        slots[i].tick = 0;
+        slots[i].pixels.assign(pixelCount, 0);
+    }
+    rgb.resize(pixelCount * 3);
+    nextTick = 0;
+    frameOpen = false;
+    head = tail = filled = 0;
+    stopping = false;
+    captured = skipped = mismatched = missing = 0;
+
+    // 1行に1フレーム: ティック 16進のハッシュ
+    if (!this->config.outputDir.empty()) {
+        std::string path = joinPath(this->config.outputDir, "hashes.txt");
+        hashFile = fopen(path.c_str(), "w");
+        if (!hashFile) {
+            SDL_Log("Failed to write %s", path.c_str());
+        }
+    }
+
+    thread = SDL_CreateThread(threadMain, "capture", this);
+    if (!thread) {
+        SDL_Log("SDL_CreateThread Error: %s", SDL_GetError());
+        closeHashFile();
+        return false;
+    }
+    return true;
+}
+
+void FrameCapture::stop() {
+    if (!thread) {
+        return;
+    }
+    SDL_LockMutex(mutex);
+    stopping = true;
+    SDL_CondSignal(frameReady);
+    SDL_UnlockMutex(mutex);
+    SDL_WaitThread(thread, nullptr);
+    thread = nullptr;
+
+    closeHashFile();
+    SDL_Log("Frame capture: %d captured, %d skipped, %d mismatched, "
+            "%d without golden image",
+            captured, skipped, mismatched, missing);
+}
+
+Uint32* FrameCapture::beginFrame(Uint32 tick) {
+    if (!thread || frameOpen || tick < nextTick) {
+        return nullptr;
+    }
+    nextTick = tick - tick % config.intervalTicks + config.intervalTicks;
+
+    SDL_LockMutex(mutex);
+    bool full = filled == FRAME_CAPTURE_SLOTS;
+    SDL_UnlockMutex(mutex);
+    if (full) {
+        // 作業スレッドが追いつくのを待たず、このフレームは諦める
+        skipped++;
+        return nullptr;
+    }
+    frameOpen = true;
+    slots[head].tick = tick;
+    return slots[head].pixels.data();
+}
+
+void FrameCapture::submitFrame() {
+    if (!frameOpen) {
+        return;
+    }
+    frameOpen = false;
+    SDL_LockMutex(mutex);
+    head = (head + 1) % FRAME_CAPTURE_SLOTS;
+    filled++;
+    SDL_CondSignal(frameReady);
+    SDL_UnlockMutex(mutex);
+}
+
+void FrameCapture::cancelFrame() {
+    if (frameOpen) {
+        frameOpen = false;
+        skipped++;
+    }
+}
+
+bool FrameCapture::passed() const { return mismatched == 0 && missing == 0; }
+
+int FrameCapture::threadMain(void* data) {
+    static_cast<FrameCapture*>(data)->run();
+    return 0;
+}
+
+void FrameCapture::run() {
+    PROFILE_THREAD_NAME("capture");
+    for (;;) {
+        SDL_LockMutex(mutex);
+        while (filled == 0 && !stopping) {
+            SDL_CondWait(frameReady, mutex);
+        }
+        if (filled == 0) {
+            // 止める指示があり、残りのフレームも無い
+            SDL_UnlockMutex(mutex);
+            return;
+        }
+        const Slot& slot = slots[tail];
+        SDL_UnlockMutex(mutex);
+
+        processFrame(slot);
+
+        SDL_LockMutex(mutex);
+        tail = (tail + 1) % FRAME_CAPTURE_SLOTS;
+        filled--;
+        SDL_UnlockMutex(mutex);
+    }
+}
+
+void FrameCapture::processFrame(const Slot& slot) {
+    PROFILE_ZONE("FrameCapture::processFrame");
+    captured++;
+
+    // アルファを除いた RGB をハッシュ・保存・比較に使う
+    const Uint32* pixels = slot.pixels.data();
+    for (size_t i = 0; i < slot.pixels.size(); i++) {
+        rgb[i * 3] = static_cast<Uint8>(pixels[i] >> 16);
+        rgb[i * 3 + 1] = static_cast<Uint8>(pixels[i] >> 8);
+        rgb[i * 3 + 2] = static_cast<Uint8>(pixels[i]);
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "frame_%06u.ppm", slot.tick);
+    if (hashFile) {
+        fprintf(hashFile, "%u %016llx\n", slot.tick,
+                static_cast<unsigned long long>(hashRgb(rgb)));
+    }
+
+    if (!config.outputDir.empty()) {
+        std::string path = joinPath(config.outputDir, name);
+        if (!writePpm(path.c_str(), pixels, width, height)) {
+            SDL_Log("Failed to write %s", path.c_str());
+        }
+    }
+    if (!config.goldenDir.empty() && !compareWithGolden(slot, name)) {
+        mismatched++;
+    }
+}
+
+bool FrameCapture::compareWithGolden(const Slot& slot, const char* name) {
+    std::string path = joinPath(config.goldenDir, name);
+    int goldenW = 0, goldenH = 0;
+    if (!readPpm(path.c_str(), golden, goldenW, goldenH)) {
+        // 正解画像の無いフレームは不一致とは別に数える
+        SDL_Log("No golden image: %s", path.c_str());
+        missing++;
+        return true;
+    }
+    if (goldenW != width || goldenH != height) {
+        SDL_Log("Golden image size differs: %s (%dx%d, frame %dx%d)",
+                path.c_str(), goldenW, goldenH, width, height);
+        return false;
+    }
+
+    // いずれかのチャンネルの差が許容値を超えたピクセルを数える
+    int differing = 0;
+    int maxDelta = 0;
+    for (size_t i = 0; i < rgb.size(); i += 3) {
+        int delta = 0;
+        for (int c = 0; c < 3; c++) {
+            int d = abs(static_cast<int>(rgb[i + c]) - golden[i + c]);
+            delta = d > delta ? d : delta;
+        }
+        if (delta > config.channelTolerance) {
+            differing++;
+        }
+        maxDelta = delta > maxDelta ? delta : maxDelta;
+    }
+    double ratio = static_cast<double>(differing) / (width * height);
+    if (ratio <= config.maxDiffRatio) {
+        return true;
+    }
+    SDL_Log("Frame at tick %u differs from %s: %d pixels (%.3f%%), "
+            "max channel delta %d",
+            slot.tick, path.c_str(), differing, ratio * 100.0, maxDelta);
+    return false;
+}
+
+void FrameCapture::closeHashFile() {
+    if (!hashFile) {
+        return;
+    }
+    // 書き出しの失敗（ディスクの空き不足など）は閉じるときにまとめて分かる
+    if (fflush(hashFile) != 0 || ferror(hashFile)) {
+        SDL_Log("Failed to write %s",
+                joinPath(config.outputDir, "hashes.txt").c_str());
+    }
+    fclose(hashFile);
+    hashFile = nullptr;
+}
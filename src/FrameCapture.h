@@ -0,0 +1,96 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// 取り込みのバッファの数（作業スレッドが遅れたときに溜められるフレーム数）
+const int FRAME_CAPTURE_SLOTS = 4;
+
+struct FrameCaptureConfig {
+    FrameCaptureConfig()
+        : intervalTicks(100), channelTolerance(2), maxDiffRatio(0.001) {}
+
+    // 取り込んだフレームを frame_<tick>.ppm で保存し、ハッシュの一覧
+    // （hashes.txt）を書き出すディレクトリ（空なら保存しない）
+    std::string outputDir;
+    // 比較に使う正解画像（同じ名前の PPM）のディレクトリ（空なら比較しない）
+    std::string goldenDir;
+    // 何ティックごとにフレームを取り込むか
+    int intervalTicks;
+    // チャンネルの差がこれ以下のピクセルは一致とみなす
+    int channelTolerance;
+    // 一致しないピクセルがこの割合以下ならフレームは一致とみなす
+    double maxDiffRatio;
+
+    bool isEnabled() const {
+        return !outputDir.empty() || !goldenDir.empty();
+    }
+};
+
+// 描画したフレームを取り込み、保存・ハッシュ・正解画像との比較を行う
+//
+// メインスレッドは空いているバッファへピクセルを読み出して渡すだけで、
+// ハッシュの計算・PPM の書き出し・正解画像の読み込みと比較は作業スレッドで
+// 行う。空きが無いときはそのフレームの取り込みを諦め（待たない）、
+// 取り込めなかった数として報告する
+class FrameCapture {
+   public:
+    FrameCapture();
+    ~FrameCapture();
+
+    // width x height のフレームの取り込みを開始する
+    bool start(const FrameCaptureConfig& config, int width, int height);
+
+    // 残りのフレームを処理してから作業スレッドを止め、結果を報告する
+    void stop();
+
+    bool isRunning() const { return thread != nullptr; }
+
+    // tick のフレームを取り込む番なら、ピクセルを書き込むバッファを返す
+    // （取り込まない・空きが無いときは nullptr）
+    Uint32* beginFrame(Uint32 tick);
+    // beginFrame で書き込んだフレームを作業スレッドへ渡す
+    void submitFrame();
+    // beginFrame で借りたバッファを使わずに返す
+    void cancelFrame();
+
+    // 取り込んだ全フレームが正解画像と一致したか（比較しない場合は true）
+    bool passed() const;
+
+   private:
+    struct Slot {
+        Uint32 tick;
+        std::vector<Uint32> pixels;
+    };
+
+    static int threadMain(void* data);
+    void run();
+    void processFrame(const Slot& slot);
+    bool compareWithGolden(const Slot& slot, const char* name);
+    void closeHashFile();
+
+    FrameCaptureConfig config;
+    int width, height;
+
+    // 取り込みの間隔（メインスレッド）
+    Uint32 nextTick;
+    bool frameOpen;
+
+    // 作業スレッドとの受け渡し（head から書き、tail から読むリング）
+    SDL_Thread* thread;
+    SDL_mutex* mutex;
+    SDL_cond* frameReady;
+    Slot slots[FRAME_CAPTURE_SLOTS];
+    int head, tail, filled;
+    bool stopping;
+
+    // ハッシュの一覧（start で開き、作業スレッドが1フレームごとに追記する）
+    // 長時間の実行でもメモリに溜めない
+    FILE* hashFile;
+
+    // 結果（作業スレッド。stop の後にメインスレッドが読む）
+    std::vector<Uint8> rgb, golden;  // 1フレーム分の作業用
+    int captured, skipped, mismatched, missing;
+};
@@ -0,0 +1,40 @@
+#include "FramePacingStats.h"
+
+// 集計の区切り（ミリ秒）
+static const Uint32 STATS_WINDOW = 1000;
+
+FramePacingStats::FramePacingStats() { start(0); }
+
+void FramePacingStats::start(Uint32 now) {
+    startTime = now;
+    windowStart = now;
+    windowIndex = 0;
+    windowWakeups = windowFrames = 0;
+    lastWakeups = lastFrames = 0;
+    totalWakeups = totalFrames = 0;
+}
+
+void FramePacingStats::countWakeup(Uint32 now) {
+    windowWakeups++;
+    totalWakeups++;
+
+    // 1秒経ったら直近の値を確定して次の区間へ
+    if (now - windowStart >= STATS_WINDOW) {
+        lastWakeups = windowWakeups;
+        lastFrames = windowFrames;
+        windowWakeups = windowFrames = 0;
+        windowStart = now;
+        windowIndex++;
+    }
+}
+
+void FramePacingStats::getAverages(Uint32 now, float& wakeupsPerSecond,
+                                   float& framesPerSecond) const {
+    float seconds = (now - startTime) / 1000.0f;
+    if (seconds <= 0.0f) {
+        wakeupsPerSecond = framesPerSecond = 0.0f;
+        return;
+    }
+    wakeupsPerSecond = totalWakeups / seconds;
+    framesPerSecond = totalFrames / seconds;
+}
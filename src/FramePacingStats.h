@@ -0,0 +1,34 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+// メインループの起床回数と描画回数を数える
+// 直近1秒間の値（オーバーレイ表示用）と、起動からの平均を求める
+class FramePacingStats {
+   public:
+    FramePacingStats();
+
+    // 計測を開始する（now: SDL_GetTicks）
+    void start(Uint32 now);
+
+    // ループが1回起きた / 1フレーム描画した
+    void countWakeup(Uint32 now);
+    void countFrame() { windowFrames++; totalFrames++; }
+
+    // 直近の1秒間の回数
+    int getWakeupsPerSecond() const { return lastWakeups; }
+    int getFramesPerSecond() const { return lastFrames; }
+    // 1秒ごとに増える番号（表示の更新判定に使う）
+    Uint32 getWindowIndex() const { return windowIndex; }
+
+    // 起動からの平均（回/秒）
+    void getAverages(Uint32 now, float& wakeupsPerSecond,
+                     float& framesPerSecond) const;
+
+   private:
+    Uint32 startTime;
+    Uint32 windowStart;
+    Uint32 windowIndex;
+    int windowWakeups, windowFrames;
+    int lastWakeups, lastFrames;
+    Uint64 totalWakeups, totalFrames;
+};
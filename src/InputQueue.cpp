@@ -0,0 +1,39 @@
+#include "InputQueue.h"
+
+InputQueue::InputQueue() : head(0), tail(0) {}
+
+bool InputQueue::push(const InputEvent& event) {
+    Uint32 t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) >= CAPACITY) {
+        return false;
+    }
+    events[t & (CAPACITY - 1)] = event;
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+bool InputQueue::peek(InputEvent& event) const {
+    Uint32 h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+    event = events[h & (CAPACITY - 1)];
+    return true;
+}
+
+void InputQueue::pop() {
+    Uint32 h = head.load(std::memory_order_relaxed);
+    if (h != tail.load(std::memory_order_acquire)) {
+        head.store(h + 1, std::memory_order_release);
+    }
+}
+
+void InputQueue::discard() {
+    head.store(tail.load(std::memory_order_acquire),
+               std::memory_order_release);
+}
+
+bool InputQueue::empty() const {
+    return head.load(std::memory_order_acquire) ==
+           tail.load(std::memory_order_acquire);
+}
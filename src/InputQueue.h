@@ -0,0 +1,43 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+#include <atomic>
+
+#include "core/Rules.h"
+
+// 取り込んだ1件の移動入力
+struct InputEvent {
+    Direction dir;
+    Uint32 timestamp;  // SDL のイベント時刻（ミリ秒、遅延計測の起点）
+    Uint64 counter;    // 取り込んだ時点の高精度カウンタ
+};
+
+// 入力を取り込む側（書き手1つ）からシミュレーション（読み手1つ）へ
+// 入力イベントを渡すロックなしのリングバッファ
+//
+// 書き手だけが tail を、読み手だけが head を進める。要素の書き込みは
+// tail の release で、読み出しは head の release で相手に公開する
+class InputQueue {
+   public:
+    // 保持できる件数（2のべき乗）
+    static const Uint32 CAPACITY = 64;
+
+    InputQueue();
+
+    // 書き手側：満杯なら捨てて false を返す
+    bool push(const InputEvent& event);
+
+    // 読み手側：先頭を見る（取り出さない）
+    bool peek(InputEvent& event) const;
+    // 読み手側：先頭を捨てる
+    void pop();
+    // 読み手側：溜まっているものをすべて捨てる
+    void discard();
+
+    bool empty() const;
+
+   private:
+    InputEvent events[CAPACITY];
+    std::atomic<Uint32> head;  // 次に読む位置（読み手が進める）
+    std::atomic<Uint32> tail;  // 次に書く位置（書き手が進める）
+};
@@ -0,0 +1,104 @@
+#include "LabelSprites.h"
+
+#include "Constants.h"
+
+// 文字列同士のにじみ防止用の余白
+static const int LABEL_PADDING = 1;
+
+BakedLabels::BakedLabels() : surface(nullptr), count(0) {}
+
+bool bakeLabels(TTF_Font* font, const char* const* labels, int count,
+                BakedLabels& baked) {
+    if (!font || count <= 0 || count > LABEL_MAX) {
+        return false;
+    }
+
+    // 白で描画しておき、色は頂点カラーで乗算する
+    SDL_Surface* labelSurfaces[LABEL_MAX];
+    int width = LABEL_PADDING;
+    int height = 0;
+    for (int i = 0; i < count; i++) {
+        labelSurfaces[i] = TTF_RenderUTF8_Blended(font, labels[i], WHITE);
+        baked.rects[i] = {width, LABEL_PADDING, 0, 0};
+        if (!labelSurfaces[i]) {
+            SDL_Log("TTF_RenderUTF8_Blended Error: %s", TTF_GetError());
+            continue;
+        }
+        baked.rects[i].w = labelSurfaces[i]->w;
+        baked.rects[i].h = labelSurfaces[i]->h;
+        width += labelSurfaces[i]->w + LABEL_PADDING;
+        if (labelSurfaces[i]->h > height) {
+            height = labelSurfaces[i]->h;
+        }
+    }
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(
+        0, width, height + LABEL_PADDING * 2, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) {
+        SDL_Log("SDL_CreateRGBSurfaceWithFormat Error: %s", SDL_GetError());
+    } else {
+        SDL_FillRect(surface, nullptr,
+                     SDL_MapRGBA(surface->format, 255, 255, 255, 0));
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (!labelSurfaces[i]) {
+            continue;
+        }
+        if (surface) {
+            // アルファ値をそのままコピーするためブレンドを切る
+            SDL_SetSurfaceBlendMode(labelSurfaces[i], SDL_BLENDMODE_NONE);
+            SDL_Rect dst = baked.rects[i];
+            SDL_BlitSurface(labelSurfaces[i], nullptr, surface, &dst);
+        }
+        SDL_FreeSurface(labelSurfaces[i]);
+    }
+
+    baked.surface = surface;
+    baked.count = count;
+    return surface != nullptr;
+}
+
+LabelSprites::LabelSprites()
+    : backend(nullptr), texture(nullptr), count(0) {}
+
+LabelSprites::~LabelSprites() { destroy(); }
+
+bool LabelSprites::initialize(RenderBackend* backend, BakedLabels& baked) {
+    destroy();
+    if (!backend || !baked.surface) {
+        return false;
+    }
+    this->backend = backend;
+    count = baked.count;
+    for (int i = 0; i < count; i++) {
+        rects[i] = baked.rects[i];
+    }
+
+    texture = backend->createTexture(baked.surface);
+    SDL_FreeSurface(baked.surface);
+    baked.surface = nullptr;
+    return texture != nullptr;
+}
+
+void LabelSprites::destroy() {
+    if (texture) {
+        backend->destroyTexture(texture);
+        texture = nullptr;
+    }
+    backend = nullptr;
+    count = 0;
+}
+
+void LabelSprites::drawCentered(RenderQueue& queue, int index,
+                                SDL_Color color, int centerX, int centerY,
+                                int layer) const {
+    if (!texture || index < 0 || index >= count || rects[index].w == 0) {
+        return;
+    }
+    const SDL_Rect& src = rects[index];
+    SDL_FRect dst = {static_cast<float>(centerX - src.w / 2),
+                     static_cast<float>(centerY - src.h / 2),
+                     static_cast<float>(src.w), static_cast<float>(src.h)};
+    queue.addSprite(texture, src, dst, color, layer);
+}
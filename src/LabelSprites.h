@@ -0,0 +1,47 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include "RenderBackend.h"
+#include "RenderQueue.h"
+
+// 1枚に焼き込める文字列の最大数
+const int LABEL_MAX = 8;
+
+// 決まった文字列（カウントダウンの数字など）を大きなサイズで焼き込んだ画像
+// （CPU側）。レンダラーを使わないので、読み込みスレッドで作ってから渡せる
+struct BakedLabels {
+    BakedLabels();
+
+    SDL_Surface* surface;
+    SDL_Rect rects[LABEL_MAX];  // 文字列ごとの位置
+    int count;
+};
+
+// labels を1枚の画像に横に並べて焼き込む（surface は呼び出し側が解放する）
+bool bakeLabels(TTF_Font* font, const char* const* labels, int count,
+                BakedLabels& baked);
+
+// 焼き込み済みの文字列を1枚のテクスチャから描画する
+// 毎回文字をラスタライズせず、四角形1つで描ける
+class LabelSprites {
+   public:
+    LabelSprites();
+    ~LabelSprites();
+
+    // 焼き込み済みの画像をテクスチャにする（baked.surface は解放される）
+    bool initialize(RenderBackend* backend, BakedLabels& baked);
+    void destroy();
+
+    // index 番目の文字列を (centerX, centerY) を中心に描画する
+    void drawCentered(RenderQueue& queue, int index, SDL_Color color,
+                      int centerX, int centerY, int layer) const;
+
+    bool isReady() const { return texture != nullptr; }
+
+   private:
+    RenderBackend* backend;
+    SDL_Texture* texture;
+    SDL_Rect rects[LABEL_MAX];
+    int count;
+};
@@ -0,0 +1,152 @@
+#include "LatencyProbe.h"
+
+#include <algorithm>
+#include <cstdio>
+
+static const char* const STAGE_NAMES[LATENCY_STAGE_COUNT] = {
+    "poll", "apply", "update", "submit", "present"};
+
+const char* getStageName(LatencyStage stage) {
+    if (stage < 0 || stage >= LATENCY_STAGE_COUNT) {
+        return "unknown";
+    }
+    return STAGE_NAMES[stage];
+}
+
+LatencyProbe::LatencyProbe()
+    : nextStage(LATENCY_STAGE_COUNT),
+      pollCounter(0),
+      historyHead(0),
+      sampleCount(0),
+      windowCount(0),
+      windowHead(0),
+      percentilesDirty(false) {
+    history.resize(LATENCY_HISTORY_SIZE);
+    current.eventTimestamp = 0;
+    for (int s = 0; s < LATENCY_STAGE_COUNT; s++) {
+        current.stageMs[s] = 0;
+        percentiles[s][0] = percentiles[s][1] = percentiles[s][2] = 0;
+    }
+}
+
+void LatencyProbe::beginSample(Uint32 eventTimestamp) {
+    beginSample(eventTimestamp, SDL_GetTicks(), SDL_GetPerformanceCounter());
+}
+
+void LatencyProbe::beginSample(Uint32 eventTimestamp, Uint32 ticks,
+                               Uint64 counter) {
+    // イベントの timestamp は SDL_GetTicks と同じ基準（ミリ秒）
+    // 取り出しまでの遅延はミリ秒精度、以降は高精度カウンタで測る
+    pollCounter = counter;
+
+    current.eventTimestamp = eventTimestamp;
+    for (int s = 0; s < LATENCY_STAGE_COUNT; s++) {
+        current.stageMs[s] = 0;
+    }
+    current.stageMs[LATENCY_POLL] =
+        ticks >= eventTimestamp ? static_cast<float>(ticks - eventTimestamp)
+                                : 0.0f;
+    nextStage = LATENCY_APPLY;
+}
+
+bool LatencyProbe::isWaitingFor(LatencyStage stage) const {
+    return nextStage == stage;
+}
+
+void LatencyProbe::markStage(LatencyStage stage) {
+    markStage(stage, SDL_GetPerformanceCounter());
+}
+
+void LatencyProbe::markStage(LatencyStage stage, Uint64 counter) {
+    if (nextStage != stage) {
+        return;
+    }
+
+    Uint64 elapsed = counter > pollCounter ? counter - pollCounter : 0;
+    float elapsedMs = static_cast<float>(
+        elapsed * 1000.0 / SDL_GetPerformanceFrequency());
+    current.stageMs[stage] = current.stageMs[LATENCY_POLL] + elapsedMs;
+
+    nextStage++;
+    if (nextStage == LATENCY_STAGE_COUNT) {
+        finishSample();
+    }
+}
+
+void LatencyProbe::finishSample() {
+    history[historyHead] = current;
+    historyHead = (historyHead + 1) % LATENCY_HISTORY_SIZE;
+    sampleCount++;
+
+    for (int s = 0; s < LATENCY_STAGE_COUNT; s++) {
+        window[s][windowHead] = current.stageMs[s];
+    }
+    windowHead = (windowHead + 1) % LATENCY_WINDOW;
+    if (windowCount < LATENCY_WINDOW) {
+        windowCount++;
+    }
+    percentilesDirty = true;
+}
+
+void LatencyProbe::updatePercentiles() {
+    float sorted[LATENCY_WINDOW];
+    for (int s = 0; s < LATENCY_STAGE_COUNT; s++) {
+        std::copy(window[s], window[s] + windowCount, sorted);
+        std::sort(sorted, sorted + windowCount);
+        percentiles[s][0] = sorted[(windowCount - 1) * 50 / 100];
+        percentiles[s][1] = sorted[(windowCount - 1) * 95 / 100];
+        percentiles[s][2] = sorted[(windowCount - 1) * 99 / 100];
+    }
+    percentilesDirty = false;
+}
+
+void LatencyProbe::getPercentiles(LatencyStage stage, float& p50, float& p95,
+                                  float& p99) {
+    if (percentilesDirty && windowCount > 0) {
+        updatePercentiles();
+    }
+    p50 = percentiles[stage][0];
+    p95 = percentiles[stage][1];
+    p99 = percentiles[stage][2];
+}
+
+bool LatencyProbe::writeCsv(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        SDL_Log("Failed to open latency CSV: %s", path);
+        return false;
+    }
+
+    // サンプルごとの値
+    fprintf(file, "event_timestamp_ms");
+    for (int s = 0; s < LATENCY_STAGE_COUNT; s++) {
+        fprintf(file, ",%s_ms", getStageName(static_cast<LatencyStage>(s)));
+    }
+    fprintf(file, "\n");
+    // 古いものから順に（リングが一周していれば historyHead が最古）
+    int stored = sampleCount < LATENCY_HISTORY_SIZE ? sampleCount
+                                                    : LATENCY_HISTORY_SIZE;
+    int first = sampleCount < LATENCY_HISTORY_SIZE ? 0 : historyHead;
+    for (int i = 0; i < stored; i++) {
+        const LatencySample& sample =
+            history[(first + i) % LATENCY_HISTORY_SIZE];
+        fprintf(file, "%u", sample.eventTimestamp);
+        for (int s = 0; s < LATENCY_STAGE_COUNT; s++) {
+            fprintf(file, ",%.3f", sample.stageMs[s]);
+        }
+        fprintf(file, "\n");
+    }
+
+    // 直近ウィンドウの集計
+    fprintf(file, "\nstage,p50_ms,p95_ms,p99_ms\n");
+    for (int s = 0; s < LATENCY_STAGE_COUNT; s++) {
+        LatencyStage stage = static_cast<LatencyStage>(s);
+        float p50, p95, p99;
+        getPercentiles(stage, p50, p95, p99);
+        fprintf(file, "%s,%.3f,%.3f,%.3f\n", getStageName(stage), p50, p95,
+                p99);
+    }
+
+    fclose(file);
+    return true;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+#include <vector>
+
+// 入力から画面反映までの各段階
+enum LatencyStage {
+    LATENCY_POLL,     // 入力キューから取り出した（ティックへの割り当て）
+    LATENCY_APPLY,    // シミュレーションへ渡した（setMovementTarget）
+    LATENCY_UPDATE,   // 移動開始を含むティックの更新完了
+    LATENCY_SUBMIT,   // 移動中のプレイヤーを含むフレームの描画発行
+    LATENCY_PRESENT,  // そのフレームの SDL_RenderPresent 完了
+    LATENCY_STAGE_COUNT
+};
+
+// 段階の短い名前（CSV の列名とオーバーレイの表示に使う）
+const char* getStageName(LatencyStage stage);
+
+// 直近何件のサンプルでパーセンタイルを計算するか
+const int LATENCY_WINDOW = 256;
+// CSV 出力用に残すサンプルの件数（これより古いものは上書きする）
+// 最初に確保し、長時間の実行でも増やさない
+const int LATENCY_HISTORY_SIZE = 4096;
+
+// 1回の入力についての計測結果
+// 各段階の値はイベントの timestamp からの経過時間（ミリ秒）
+struct LatencySample {
+    Uint32 eventTimestamp;
+    float stageMs[LATENCY_STAGE_COUNT];
+};
+
+// 入力→画面反映の遅延を計測する
+// キー入力イベントの timestamp を起点に各段階の到達時刻を記録し、
+// 直近のサンプルから p50/p95/p99 を求める
+class LatencyProbe {
+   public:
+    LatencyProbe();
+
+    // 受け付けた入力イベントで計測を開始する
+    void beginSample(Uint32 eventTimestamp);
+    // 別スレッドで記録した取り出し時刻（SDL_GetTicks と高精度カウンタ）で
+    // 計測を開始する
+    void beginSample(Uint32 eventTimestamp, Uint32 pollTicks,
+                     Uint64 pollCounter);
+
+    // 計測中のサンプルが stage に到達したことを記録する
+    // 直前の段階まで進んでいない場合は何もしない
+    void markStage(LatencyStage stage);
+    // 到達した時刻（高精度カウンタ）を指定して記録する
+    void markStage(LatencyStage stage, Uint64 counter);
+
+    // 次に stage の到達を待っているか
+    bool isWaitingFor(LatencyStage stage) const;
+
+    // 直近のサンプルから段階ごとのパーセンタイルを求める（ミリ秒）
+    void getPercentiles(LatencyStage stage, float& p50, float& p95,
+                        float& p99);
+
+    // これまでに計測を終えたサンプルの数
+    int getSampleCount() const { return sampleCount; }
+
+    // 直近の LATENCY_HISTORY_SIZE 件のサンプルと集計値をCSVに書き出す
+    bool writeCsv(const char* path);
+
+   private:
+    void finishSample();
+    void updatePercentiles();
+
+    // 計測中のサンプル
+    LatencySample current;
+    int nextStage;  // 次に記録する段階（LATENCY_STAGE_COUNT なら計測なし）
+    Uint64 pollCounter;
+
+    // 直近のサンプル（CSV出力用のリングバッファ）
+    std::vector<LatencySample> history;
+    int historyHead;  // 次に書く位置
+    int sampleCount;
+
+    // 直近のサンプル（段階ごとのリングバッファ）
+    float window[LATENCY_STAGE_COUNT][LATENCY_WINDOW];
+    int windowCount;
+    int windowHead;
+
+    // パーセンタイルのキャッシュ（サンプル追加時のみ再計算）
+    float percentiles[LATENCY_STAGE_COUNT][3];
+    bool percentilesDirty;
+};
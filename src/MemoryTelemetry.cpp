@@ -0,0 +1,163 @@
+#include "MemoryTelemetry.h"
+
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <malloc/malloc.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#if __GLIBC_PREREQ(2, 33)
+#define MEMORY_TELEMETRY_MALLINFO2 1
+#endif
+#endif
+
+// テクスチャの集計（メインスレッドだけが触る）
+static int textureCount = 0;
+static size_t textureBytes = 0;
+static size_t texturePeakBytes = 0;
+static Uint64 texturesCreated = 0;
+
+static size_t getTextureBytes(SDL_Texture* texture) {
+    Uint32 format = 0;
+    int w = 0, h = 0;
+    if (!texture || SDL_QueryTexture(texture, &format, nullptr, &w, &h) != 0) {
+        return 0;
+    }
+    return static_cast<size_t>(w) * h * SDL_BYTESPERPIXEL(format);
+}
+
+void trackTextureCreated(SDL_Texture* texture) {
+    if (!texture) {
+        return;
+    }
+    textureCount++;
+    textureBytes += getTextureBytes(texture);
+    texturesCreated++;
+    if (textureBytes > texturePeakBytes) {
+        texturePeakBytes = textureBytes;
+    }
+}
+
+void trackTextureDestroyed(SDL_Texture* texture) {
+    if (!texture) {
+        return;
+    }
+    textureCount--;
+    textureBytes -= getTextureBytes(texture);
+}
+
+Uint64 getTexturesCreated() { return texturesCreated; }
+
+size_t getResidentMemory() {
+#if defined(__linux__)
+    // statm の2番目の値が常駐ページ数（毎秒読むので FILE* は使わない）
+    int fd = open("/proc/self/statm", O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    char buffer[128];
+    ssize_t length = read(fd, buffer, sizeof(buffer) - 1);
+    close(fd);
+    if (length <= 0) {
+        return 0;
+    }
+    buffer[length] = '\0';
+    char* end = nullptr;
+    strtoul(buffer, &end, 10);
+    unsigned long resident = strtoul(end, nullptr, 10);
+    return static_cast<size_t>(resident) * sysconf(_SC_PAGESIZE);
+#elif defined(__APPLE__)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&info), &count) !=
+        KERN_SUCCESS) {
+        return 0;
+    }
+    return static_cast<size_t>(info.resident_size);
+#else
+    return 0;
+#endif
+}
+
+size_t getHeapInUse() {
+#if defined(MEMORY_TELEMETRY_MALLINFO2)
+    // 使用中の通常の領域と mmap で確保した大きい領域
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#elif defined(__GLIBC__)
+    // 古い glibc（int なので 2GB を超えると正しくない）
+    struct mallinfo info = mallinfo();
+    return static_cast<unsigned int>(info.uordblks) +
+           static_cast<unsigned int>(info.hblkhd);
+#elif defined(__APPLE__)
+    malloc_statistics_t stats;
+    malloc_zone_statistics(nullptr, &stats);
+    return stats.size_in_use;
+#else
+    return 0;
+#endif
+}
+
+MemorySample sampleMemory() {
+    MemorySample sample;
+    sample.textureCount = textureCount;
+    sample.textureBytes = textureBytes;
+    sample.heapBytes = getHeapInUse();
+    sample.residentBytes = getResidentMemory();
+    return sample;
+}
+
+MemoryTelemetry::MemoryTelemetry()
+    : lastSample(0), lastLog(0), loggedTextures(0) {}
+
+void MemoryTelemetry::start(Uint32 now) {
+    lastSample = now;
+    lastLog = now;
+    loggedTextures = texturesCreated;
+    current = sampleMemory();
+    peak = current;
+}
+
+bool MemoryTelemetry::update(Uint32 now) {
+    if (now - lastSample < MEMORY_SAMPLE_INTERVAL) {
+        return false;
+    }
+    lastSample = now;
+    current = sampleMemory();
+    if (current.textureCount > peak.textureCount) {
+        peak.textureCount = current.textureCount;
+    }
+    // テクスチャは作成のたびに数えているので、標本の間の山も入る
+    if (texturePeakBytes > peak.textureBytes) {
+        peak.textureBytes = texturePeakBytes;
+    }
+    if (current.heapBytes > peak.heapBytes) {
+        peak.heapBytes = current.heapBytes;
+    }
+    if (current.residentBytes > peak.residentBytes) {
+        peak.residentBytes = current.residentBytes;
+    }
+    return true;
+}
+
+void MemoryTelemetry::logUsage(Uint32 now) {
+    const double MB = 1024.0 * 1024.0;
+    // 前回のログから作ったテクスチャの数（描画中の作り直しがあれば増える）
+    Uint64 created = texturesCreated - loggedTextures;
+    loggedTextures = texturesCreated;
+    lastLog = now;
+
+    SDL_Log("Memory: textures %d (%.2f MB, peak %.2f MB, %lu created), "
+            "heap %.1f MB (peak %.1f MB), RSS %.1f MB (peak %.1f MB)",
+            current.textureCount, current.textureBytes / MB,
+            peak.textureBytes / MB, static_cast<unsigned long>(created),
+            current.heapBytes / MB, peak.heapBytes / MB,
+            current.residentBytes / MB, peak.residentBytes / MB);
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+#include <stddef.h>
+
+// 標本を取る間隔と、ログに1行出す間隔（ミリ秒）
+const Uint32 MEMORY_SAMPLE_INTERVAL = 1000;
+const Uint32 MEMORY_LOG_INTERVAL = 60000;
+
+// ある時点のメモリの使用量
+struct MemorySample {
+    MemorySample()
+        : textureCount(0), textureBytes(0), heapBytes(0), residentBytes(0) {}
+
+    int textureCount;      // 存在するテクスチャの数
+    size_t textureBytes;   // 画素のバイト数（幅 x 高さ x 1画素のバイト数）
+    size_t heapBytes;      // malloc で使用中のバイト数（取れない環境では 0）
+    size_t residentBytes;  // 常駐メモリ（取れない環境では 0）
+};
+
+// 描画バックエンドがテクスチャを作った・破棄する直前に呼ぶ（メインスレッド）
+void trackTextureCreated(SDL_Texture* texture);
+void trackTextureDestroyed(SDL_Texture* texture);
+
+// これまでに作ったテクスチャの数（作り直しの多さを見る）
+Uint64 getTexturesCreated();
+
+// 現在の常駐メモリ（Linux は /proc/self/statm、macOS は task_info）
+size_t getResidentMemory();
+
+// malloc で使用中のバイト数（glibc は mallinfo2、macOS は malloc_zone）
+// SDL やドライバが内部で確保した分も含む
+size_t getHeapInUse();
+
+// 現在の使用量を調べる（ヒープ確保はしないので定常状態でも呼べる）
+MemorySample sampleMemory();
+
+// メモリの使用量の追跡（F1 のオーバーレイと定期的なログ）
+//
+// 1秒ごとに標本を取って最大値（ヒープの最高水位など）を更新し、1分ごとに
+// ログへ1行出す。テクスチャ以外は標本の間の一時的な山が最大値に入らない
+class MemoryTelemetry {
+   public:
+    MemoryTelemetry();
+
+    // 追跡を開始する（now: SDL_GetTicks）
+    void start(Uint32 now);
+
+    // 標本を取る時刻なら取る。取ったら true
+    bool update(Uint32 now);
+
+    // ログに出す時刻か
+    bool isLogDue(Uint32 now) const {
+        return now - lastLog >= MEMORY_LOG_INTERVAL;
+    }
+    // 現在・最大・前回のログからのテクスチャ作成数をログに出す
+    void logUsage(Uint32 now);
+
+    const MemorySample& getCurrent() const { return current; }
+    const MemorySample& getPeak() const { return peak; }
+
+   private:
+    Uint32 lastSample;
+    Uint32 lastLog;
+    Uint64 loggedTextures;  // 前回のログまでに作ったテクスチャの数
+    MemorySample current;
+    MemorySample peak;
+};
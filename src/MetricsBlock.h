@@ -0,0 +1,90 @@
+#pragma once
+#include <stdint.h>
+
+#include <atomic>
+#include <cstring>
+
+// 外部の監視ツールへ公開するメトリクスの共有メモリの配置
+// ゲーム（MetricsPublisher）と読み出しツール（tools/metrics.cpp）で共有する
+// SDL に依存しない。配置を変えたら METRICS_VERSION を上げる
+
+const uint32_t METRICS_MAGIC = 0x4D475743;  // "CWGM"
+const uint32_t METRICS_VERSION = 1;
+
+// 既定の共有メモリ名の接頭辞（後ろにプロセスIDを付ける）
+#define METRICS_SHM_PREFIX "/color-wall-game."
+
+// 公開する値（すべて固定長の整数・浮動小数点）
+struct MetricsData {
+    uint64_t frames;             // 描画したフレーム数
+    uint64_t loops;              // メインループの回数（= 公開した回数）
+    uint32_t frameIntervalUs;    // 直前のフレームとの間隔
+    uint32_t renderUs;           // 直前のフレームの描画にかかった時間
+    uint32_t updateUs;           // 直前のティックの更新にかかった時間
+    uint32_t framesPerSecond;    // 直近1秒間の描画回数
+    float latencyP50Ms;          // 入力→画面反映の遅延（直近のサンプル）
+    float latencyP95Ms;
+    float latencyP99Ms;
+    uint32_t latencySamples;
+    int32_t score;
+    int32_t gameState;           // GameState
+    uint32_t simTime;            // ゲーム内の時刻（ミリ秒）
+    uint32_t reserved;
+    uint64_t allocations;        // ヒープ確保の回数（make alloccheck のみ）
+    uint64_t texturesCreated;    // これまでに作ったテクスチャの数
+    uint64_t textureBytes;
+    uint64_t heapBytes;
+    uint64_t residentBytes;
+};
+
+// 共有メモリの先頭に置くブロック
+//
+// 書き手は1つ（ゲームのメインスレッド）。sequence を奇数にしてから値を
+// 書き、偶数に戻して公開する（seqlock）。読み手は書き込み中（奇数）や
+// 読んでいる間に sequence が変わった場合に読み直す
+struct MetricsBlock {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;  // sizeof(MetricsBlock)
+    uint32_t pid;   // 書き手のプロセスID
+    std::atomic<uint32_t> sequence;
+    uint32_t reserved;
+    MetricsData data;
+};
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "sequence must have the same layout in every process");
+// ロックで実装された atomic はプロセスをまたいで共有できない
+static_assert(ATOMIC_INT_LOCK_FREE == 2,
+              "sequence must be lock-free to be shared between processes");
+
+// 書き込みを始める（この後 data の値を書く）
+inline void beginMetricsWrite(MetricsBlock* block) {
+    uint32_t sequence = block->sequence.load(std::memory_order_relaxed);
+    block->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+// 書き込みを終えて公開する
+inline void endMetricsWrite(MetricsBlock* block) {
+    uint32_t sequence = block->sequence.load(std::memory_order_relaxed);
+    block->sequence.store(sequence + 1, std::memory_order_release);
+}
+
+// 一貫した値を out に読み出す。maxTries 回とも書き込みと重なったら false
+inline bool readMetrics(const MetricsBlock* block, MetricsData& out,
+                        int maxTries) {
+    for (int i = 0; i < maxTries; i++) {
+        uint32_t before = block->sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+        memcpy(&out, &block->data, sizeof(out));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint32_t after = block->sequence.load(std::memory_order_relaxed);
+        if (before == after) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,92 @@
+#include "MetricsPublisher.h"
+
+#include <SDL2/SDL.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define METRICS_POSIX_SHM 1
+#endif
+
+MetricsPublisher::MetricsPublisher() : block(nullptr) {}
+
+MetricsPublisher::~MetricsPublisher() { close(); }
+
+bool MetricsPublisher::open(const std::string& name) {
+#ifdef METRICS_POSIX_SHM
+    close();
+    // 既にある共有メモリ（他のプロセスが使用中、または異常終了で残ったもの）
+    // は開かない。別の書き手と同じブロックを書き換えると seqlock が壊れる
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        if (errno == EEXIST) {
+            SDL_Log("Shared memory %s already exists (another game is "
+                    "publishing, or a crashed one left it; remove "
+                    "/dev/shm%s or use another --metrics-name)",
+                    name.c_str(), name.c_str());
+        } else {
+            SDL_Log("shm_open Error: %s: %s", name.c_str(), strerror(errno));
+        }
+        return false;
+    }
+    if (ftruncate(fd, sizeof(MetricsBlock)) != 0) {
+        SDL_Log("ftruncate Error: %s", name.c_str());
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+    void* memory = mmap(nullptr, sizeof(MetricsBlock), PROT_READ | PROT_WRITE,
+                        MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        SDL_Log("mmap Error: %s", name.c_str());
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    // 値を消し、ヘッダを書いてから公開する
+    block = static_cast<MetricsBlock*>(memory);
+    memset(&block->data, 0, sizeof(block->data));
+    block->size = sizeof(MetricsBlock);
+    block->pid = static_cast<uint32_t>(getpid());
+    block->sequence.store(0, std::memory_order_relaxed);
+    block->reserved = 0;
+    block->version = METRICS_VERSION;
+    std::atomic_thread_fence(std::memory_order_release);
+    block->magic = METRICS_MAGIC;
+    this->name = name;
+    SDL_Log("Publishing metrics in shared memory %s", name.c_str());
+    return true;
+#else
+    SDL_Log("Shared-memory metrics are not supported here: %s",
+            name.c_str());
+    return false;
+#endif
+}
+
+std::string MetricsPublisher::getDefaultName() {
+    unsigned long pid = 0;
+#ifdef METRICS_POSIX_SHM
+    pid = static_cast<unsigned long>(getpid());
+#endif
+    char name[64];
+    snprintf(name, sizeof(name), "%s%lu", METRICS_SHM_PREFIX, pid);
+    return name;
+}
+
+void MetricsPublisher::close() {
+#ifdef METRICS_POSIX_SHM
+    if (!block) {
+        return;
+    }
+    munmap(block, sizeof(MetricsBlock));
+    shm_unlink(name.c_str());
+    block = nullptr;
+    name.clear();
+#endif
+}
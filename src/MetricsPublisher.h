@@ -0,0 +1,40 @@
+#pragma once
+#include <string>
+
+#include "MetricsBlock.h"
+
+// メトリクスを POSIX 共有メモリ（shm_open）に公開する
+//
+// 開くときに共有メモリを作って割り当て、以降の更新はメモリへの書き込み
+// だけで済ませる（システムコールもファイル出力も無い）。閉じるときに
+// 共有メモリの名前を消す。POSIX でない環境では開けない
+class MetricsPublisher {
+   public:
+    MetricsPublisher();
+    ~MetricsPublisher();
+
+    // name（"/" で始まる名前）の共有メモリを作って公開を始める
+    bool open(const std::string& name);
+    void close();
+
+    // 既定の名前（METRICS_SHM_PREFIX + このプロセスのID）
+    static std::string getDefaultName();
+
+    bool isOpen() const { return block != nullptr; }
+    const std::string& getName() const { return name; }
+
+    // 値を書き換える間だけ data を返す（開いていなければ nullptr）
+    // 書き終えたら endUpdate を呼ぶ
+    MetricsData* beginUpdate() {
+        if (!block) {
+            return nullptr;
+        }
+        beginMetricsWrite(block);
+        return &block->data;
+    }
+    void endUpdate() { endMetricsWrite(block); }
+
+   private:
+    MetricsBlock* block;
+    std::string name;
+};
@@ -0,0 +1,18 @@
+#include "PlayerRenderer.h"
+
+#include "Constants.h"
+#include "ProfileZones.h"
+
+void renderPlayer(RenderQueue& queue, float x, float y,
+                  const CircleSprite* sprite) {
+    PROFILE_ZONE("renderPlayer");
+
+    if (sprite && sprite->isReady()) {
+        sprite->draw(queue, x, y, WHITE, LAYER_PLAYER);
+        return;
+    }
+
+    // スプライトが無い場合は三角形ファンで描画
+    drawFilledCircle(queue, x, y, static_cast<float>(PLAYER_RADIUS), WHITE,
+                     LAYER_PLAYER);
+}
\ No newline at end of file
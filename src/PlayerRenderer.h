@@ -0,0 +1,11 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+#include "Primitives.h"
+#include "RenderQueue.h"
+
+// プレイヤーを白い円として (x, y) に描画する
+// 座標はティック間で補間した値を渡せるよう Player とは別に受け取る
+// 焼き込み済みスプライトがあればそれを貼り、無ければ三角形ファンで描く
+void renderPlayer(RenderQueue& queue, float x, float y,
+                  const CircleSprite* sprite = nullptr);
\ No newline at end of file
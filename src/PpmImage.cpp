@@ -0,0 +1,42 @@
+#include "PpmImage.h"
+
+#include <cstdio>
+
+bool writePpm(const char* path, const Uint32* pixels, int width,
+              int height) {
+    FILE* out = fopen(path, "wb");
+    if (!out) {
+        return false;
+    }
+    fprintf(out, "P6\n%d %d\n255\n", width, height);
+    std::vector<Uint8> row(static_cast<size_t>(width) * 3);
+    for (int y = 0; y < height; y++) {
+        const Uint32* line = pixels + static_cast<size_t>(y) * width;
+        for (int x = 0; x < width; x++) {
+            row[x * 3] = static_cast<Uint8>(line[x] >> 16);
+            row[x * 3 + 1] = static_cast<Uint8>(line[x] >> 8);
+            row[x * 3 + 2] = static_cast<Uint8>(line[x]);
+        }
+        fwrite(row.data(), 1, row.size(), out);
+    }
+    return fclose(out) == 0;
+}
+
+bool readPpm(const char* path, std::vector<Uint8>& rgb, int& width,
+             int& height) {
+    FILE* in = fopen(path, "rb");
+    if (!in) {
+        return false;
+    }
+    // このプログラムが書いた形式（コメントなし、最大値 255）だけを読む
+    int maxValue = 0;
+    bool ok = fscanf(in, "P6 %d %d %d", &width, &height, &maxValue) == 3 &&
+              maxValue == 255 && width > 0 && height > 0 &&
+              fgetc(in) != EOF;
+    if (ok) {
+        rgb.resize(static_cast<size_t>(width) * height * 3);
+        ok = fread(rgb.data(), 1, rgb.size(), in) == rgb.size();
+    }
+    fclose(in);
+    return ok;
+}
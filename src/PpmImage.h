@@ -0,0 +1,14 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+#include <vector>
+
+// 画面の画像を PPM（P6、RGB 各8ビット）で読み書きする
+// 外部の画像ライブラリを使わずに済み、差分ツールでもそのまま開ける
+
+// ARGB のピクセル（1行 = width ピクセル）を書き出す。アルファは捨てる
+bool writePpm(const char* path, const Uint32* pixels, int width, int height);
+
+// RGB のバイト列として読み込む（rgb は width * height * 3 バイトになる）
+bool readPpm(const char* path, std::vector<Uint8>& rgb, int& width,
+             int& height);
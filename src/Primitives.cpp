@@ -0,0 +1,114 @@
+#include "Primitives.h"
+
+#include <cmath>
+
+// 焼き込み時の1ピクセルあたりのサンプル数（一辺）
+static const int CIRCLE_SUPERSAMPLE = 4;
+
+// ファン描画の外周の最大分割数
+static const int MAX_CIRCLE_SEGMENTS = 128;
+
+CircleSprite::CircleSprite()
+    : backend(nullptr), texture(nullptr), radius(0) {}
+
+CircleSprite::~CircleSprite() { destroy(); }
+
+bool CircleSprite::create(RenderBackend* backend, int radius) {
+    destroy();
+    if (!backend || radius <= 0) {
+        return false;
+    }
+    this->backend = backend;
+    this->radius = radius;
+
+    int size = radius * 2;
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(
+        0, size, size, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) {
+        SDL_Log("SDL_CreateRGBSurfaceWithFormat Error: %s", SDL_GetError());
+        return false;
+    }
+
+    // 各ピクセルをサブサンプルし、円に含まれる割合をアルファ値にする
+    SDL_LockSurface(surface);
+    const float step = 1.0f / CIRCLE_SUPERSAMPLE;
+    const float r2 = static_cast<float>(radius * radius);
+    const int samples = CIRCLE_SUPERSAMPLE * CIRCLE_SUPERSAMPLE;
+    for (int py = 0; py < size; py++) {
+        Uint32* row = reinterpret_cast<Uint32*>(
+            static_cast<Uint8*>(surface->pixels) + py * surface->pitch);
+        for (int px = 0; px < size; px++) {
+            int covered = 0;
+            for (int sy = 0; sy < CIRCLE_SUPERSAMPLE; sy++) {
+                float dy = py + (sy + 0.5f) * step - radius;
+                for (int sx = 0; sx < CIRCLE_SUPERSAMPLE; sx++) {
+                    float dx = px + (sx + 0.5f) * step - radius;
+                    if (dx * dx + dy * dy <= r2) {
+                        covered++;
+                    }
+                }
+            }
+            Uint8 alpha = static_cast<Uint8>(covered * 255 / samples);
+            row[px] = SDL_MapRGBA(surface->format, 255, 255, 255, alpha);
+        }
+    }
+    SDL_UnlockSurface(surface);
+
+    texture = backend->createTexture(surface);
+    SDL_FreeSurface(surface);
+    return texture != nullptr;
+}
+
+void CircleSprite::destroy() {
+    if (texture) {
+        backend->destroyTexture(texture);
+        texture = nullptr;
+    }
+    backend = nullptr;
+    radius = 0;
+}
+
+void CircleSprite::draw(RenderQueue& queue, float centerX, float centerY,
+                        SDL_Color color, int layer) const {
+    if (!texture) {
+        return;
+    }
+    // 色はテクスチャの色変調ではなく頂点カラーで乗算する
+    // （色ごとにテクスチャの状態を変えないのでまとめて描画できる）
+    SDL_Rect src = {0, 0, radius * 2, radius * 2};
+    SDL_FRect dst = {centerX - radius, centerY - radius,
+                     static_cast<float>(radius * 2),
+                     static_cast<float>(radius * 2)};
+    queue.addSprite(texture, src, dst, color, layer);
+}
+
+void drawFilledCircle(RenderQueue& queue, float centerX, float centerY,
+                      float radius, SDL_Color color, int layer,
+                      int segments) {
+    if (segments < 3) {
+        segments = 3;
+    }
+    if (segments > MAX_CIRCLE_SEGMENTS) {
+        segments = MAX_CIRCLE_SEGMENTS;
+    }
+
+    // 中心 + 外周の頂点をファン状の三角形リストとして積む
+    SDL_Vertex vertices[MAX_CIRCLE_SEGMENTS + 1];
+    int indices[MAX_CIRCLE_SEGMENTS * 3];
+
+    vertices[0] = {{centerX, centerY}, color, {0.0f, 0.0f}};
+    const float twoPi = 6.28318530718f;
+    for (int i = 0; i < segments; i++) {
+        float angle = twoPi * i / segments;
+        vertices[i + 1] = {{centerX + radius * std::cos(angle),
+                            centerY + radius * std::sin(angle)},
+                           color,
+                           {0.0f, 0.0f}};
+        indices[i * 3] = 0;
+        indices[i * 3 + 1] = i + 1;
+        indices[i * 3 + 2] = (i + 1) % segments + 1;
+    }
+
+    queue.addTriangles(nullptr, vertices, segments + 1, indices,
+                       segments * 3, layer);
+}
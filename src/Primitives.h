@@ -0,0 +1,38 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+#include "RenderBackend.h"
+#include "RenderQueue.h"
+
+// 円の描画方法（どちらも描画キューに積む）
+// - CircleSprite: アンチエイリアス済みの円を1回だけテクスチャに焼き込み、
+//   以降は四角形1つとして描画する
+// - drawFilledCircle: 三角形ファンとして描画（テクスチャ不要）
+
+// 焼き込み済みの円スプライト
+class CircleSprite {
+   public:
+    CircleSprite();
+    ~CircleSprite();
+
+    // 半径 radius の白い円を焼き込む（色は描画時に乗算）
+    bool create(RenderBackend* backend, int radius);
+    void destroy();
+
+    // (centerX, centerY) を中心に color で描画する
+    void draw(RenderQueue& queue, float centerX, float centerY,
+              SDL_Color color, int layer) const;
+
+    bool isReady() const { return texture != nullptr; }
+    int getRadius() const { return radius; }
+
+   private:
+    RenderBackend* backend;
+    SDL_Texture* texture;
+    int radius;
+};
+
+// 円を三角形ファンとして塗りつぶす（segments: 外周の分割数）
+void drawFilledCircle(RenderQueue& queue, float centerX, float centerY,
+                      float radius, SDL_Color color, int layer,
+                      int segments = 32);
@@ -0,0 +1,121 @@
+#include "ProfileZones.h"
+
+#ifdef PROFILE_ZONES
+
+#include <atomic>
+#include <cstdio>
+
+struct ProfileEvent {
+    const char* name;
+    Uint64 begin;
+    Uint64 end;
+};
+
+// 1スレッド分のリングバッファ（書き込むのはそのスレッドだけ）
+// 書き出しは実行中のスレッドと並行して読むので、枠が上書きされうる
+// （seqlock と同じ考え方）。書き手は release フェンスで前の count の
+// 公開を枠の書き換えより前に終わらせ、書き終えてから count を release で
+// 進める。書き出し側は区間を読んだ後に acquire フェンスを置いて count を
+// 見直し、読んでいる間に上書きされ始めた区間を捨てる
+struct ProfileThread {
+    ProfileEvent events[PROFILE_RING_SIZE];
+    std::atomic<Uint32> count;  // 書き込んだ区間の総数
+    int id;
+    std::atomic<const char*> name;
+    ProfileThread* next;  // 登録済みのスレッドの一覧
+};
+
+static std::atomic<ProfileThread*> profileThreads(nullptr);
+static std::atomic<int> nextThreadId(1);
+static std::atomic<Uint64> profileOrigin(0);
+static thread_local ProfileThread* currentThread = nullptr;
+
+// 呼び出したスレッドのバッファ（初回だけ確保して一覧に加える）
+static ProfileThread* getProfileThread() {
+    if (currentThread) {
+        return currentThread;
+    }
+    Uint64 unset = 0;
+    profileOrigin.compare_exchange_strong(unset, SDL_GetPerformanceCounter());
+
+    ProfileThread* thread = new ProfileThread();
+    thread->count.store(0);
+    thread->id = nextThreadId.fetch_add(1);
+    thread->name.store(nullptr);
+    thread->next = profileThreads.load();
+    while (!profileThreads.compare_exchange_weak(thread->next, thread)) {
+    }
+    currentThread = thread;
+    return thread;
+}
+
+ProfileZone::~ProfileZone() {
+    ProfileThread* thread = getProfileThread();
+    Uint32 index = thread->count.load(std::memory_order_relaxed);
+    // 書き出し側が古い count のまま書き換え途中の枠を読まないよう、枠への
+    // 書き込みを前の count の公開より後に並べる（beginMetricsWrite と同じ）
+    std::atomic_thread_fence(std::memory_order_release);
+    ProfileEvent& event = thread->events[index & (PROFILE_RING_SIZE - 1)];
+    event.name = name;
+    event.begin = begin;
+    event.end = SDL_GetPerformanceCounter();
+    thread->count.store(index + 1, std::memory_order_release);
+}
+
+void profileSetThreadName(const char* name) {
+    getProfileThread()->name.store(name);
+}
+
+bool profileWriteTrace(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+
+    // trace_event の時刻はマイクロ秒
+    const double usPerCount = 1e6 / SDL_GetPerformanceFrequency();
+    const Uint64 origin = profileOrigin.load();
+
+    fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    bool first = true;
+    for (ProfileThread* thread = profileThreads.load(); thread;
+         thread = thread->next) {
+        const char* name = thread->name.load();
+        if (name) {
+            fprintf(file,
+                    "%s{\"name\": \"thread_name\", \"ph\": \"M\", "
+                    "\"pid\": 1, \"tid\": %d, \"args\": {\"name\": \"%s\"}}",
+                    first ? "" : ",\n", thread->id, name);
+            first = false;
+        }
+
+        Uint32 end = thread->count.load(std::memory_order_acquire);
+        Uint32 begin = end > PROFILE_RING_SIZE ? end - PROFILE_RING_SIZE : 0;
+        for (Uint32 i = begin; i != end; i++) {
+            ProfileEvent event = thread->events[i & (PROFILE_RING_SIZE - 1)];
+            // 読んでいる間に上書きされた（書き込み中を含む）区間は捨てる
+            // count が i + PROFILE_RING_SIZE の間、書き手はこの枠を書き換えて
+            // いる途中なので、それ以上なら使えない。書き手のフェンスと対になる
+            // フェンスで、区間の読み出しを count の読み直しより前に終わらせる
+            std::atomic_thread_fence(std::memory_order_acquire);
+            Uint32 now = thread->count.load(std::memory_order_relaxed);
+            if (now - i >= PROFILE_RING_SIZE) {
+                continue;
+            }
+            fprintf(file,
+                    "%s{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, "
+                    "\"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}",
+                    first ? "" : ",\n", event.name, thread->id,
+                    static_cast<Sint64>(event.begin - origin) * usPerCount,
+                    (event.end - event.begin) * usPerCount);
+            first = false;
+        }
+    }
+    fprintf(file, "\n]}\n");
+
+    bool ok = ferror(file) == 0;
+    fclose(file);
+    return ok;
+}
+
+#endif
@@ -0,0 +1,59 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+// 区間計測（プロファイルゾーン）
+//
+// PROFILE_ZONES を定義したビルド（make profile）でのみ有効になる。
+// 無効なビルドではマクロが空になり、計測のコードは一切残らない
+//
+// 各スレッドは専用のリングバッファに区間の開始・終了時刻（高精度カウンタ）を
+// 書き込む。書き出し時は全スレッドの直近の区間を Chrome の trace_event 形式の
+// JSON にする（chrome://tracing や Perfetto で開ける）
+//
+// 使い方:
+//   void Game::render(float alpha) {
+//       PROFILE_ZONE("Game::render");  // スコープの終わりまでを計測
+//       ...
+
+#ifdef PROFILE_ZONES
+
+const bool PROFILE_ZONES_ENABLED = true;
+
+// スレッドごとに保持する区間の数（2のべき乗）
+const Uint32 PROFILE_RING_SIZE = 16384;
+
+// コンストラクタからデストラクタまでを1つの区間として記録する
+// name は文字列リテラルなど、書き出しまで有効なものを渡す
+class ProfileZone {
+   public:
+    explicit ProfileZone(const char* name)
+        : name(name), begin(SDL_GetPerformanceCounter()) {}
+    ~ProfileZone();
+
+   private:
+    const char* name;
+    Uint64 begin;
+};
+
+// 呼び出したスレッドの表示名を設定する
+void profileSetThreadName(const char* name);
+
+// 記録済みの区間を path に書き出す
+bool profileWriteTrace(const char* path);
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) \
+    ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_THREAD_NAME(name) profileSetThreadName(name)
+#define PROFILE_WRITE_TRACE(path) profileWriteTrace(path)
+
+#else
+
+const bool PROFILE_ZONES_ENABLED = false;
+
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#define PROFILE_WRITE_TRACE(path) (false)
+
+#endif
@@ -0,0 +1,115 @@
+#include "RenderBackend.h"
+
+#include "Constants.h"
+#include "MemoryTelemetry.h"
+
+SdlRenderBackend::SdlRenderBackend()
+    : renderer(nullptr), layer(nullptr), layerUnavailable(false) {}
+
+SdlRenderBackend::~SdlRenderBackend() { destroy(); }
+
+void SdlRenderBackend::initialize(SDL_Renderer* renderer) {
+    destroy();
+    this->renderer = renderer;
+}
+
+void SdlRenderBackend::destroy() {
+    destroyLayer();
+    layerUnavailable = false;
+    renderer = nullptr;
+}
+
+void SdlRenderBackend::destroyLayer() {
+    if (layer) {
+        trackTextureDestroyed(layer);
+        SDL_DestroyTexture(layer);
+        layer = nullptr;
+    }
+}
+
+SDL_Texture* SdlRenderBackend::createTexture(SDL_Surface* surface) {
+    if (!renderer || !surface) {
+        return nullptr;
+    }
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (!texture) {
+        SDL_Log("SDL_CreateTextureFromSurface Error: %s", SDL_GetError());
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    trackTextureCreated(texture);
+    return texture;
+}
+
+void SdlRenderBackend::destroyTexture(SDL_Texture* texture) {
+    if (texture) {
+        trackTextureDestroyed(texture);
+        SDL_DestroyTexture(texture);
+    }
+}
+
+void SdlRenderBackend::clear(SDL_Color color) {
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderClear(renderer);
+}
+
+void SdlRenderBackend::drawGeometry(SDL_Texture* texture,
+                                    const SDL_Vertex* vertices,
+                                    int vertexCount, const int* indices,
+                                    int indexCount) {
+    SDL_RenderGeometry(renderer, texture, vertices, vertexCount, indices,
+                       indexCount);
+}
+
+bool SdlRenderBackend::beginLayer() {
+    if (layerUnavailable) {
+        return false;
+    }
+    if (!layer) {
+        // 失敗は1回だけ記録し、以降は呼び出し側が毎フレーム描き直す
+        // （作り直しを繰り返すと定常状態でもヒープを確保してしまう）
+        if (!SDL_RenderTargetSupported(renderer)) {
+            SDL_Log("Render targets are not supported; drawing the static "
+                    "layer every frame");
+            layerUnavailable = true;
+            return false;
+        }
+        layer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                                  SDL_TEXTUREACCESS_TARGET, WINDOW_WIDTH,
+                                  WINDOW_HEIGHT);
+        if (!layer) {
+            SDL_Log("SDL_CreateTexture Error: %s; drawing the static layer "
+                    "every frame",
+                    SDL_GetError());
+            layerUnavailable = true;
+            return false;
+        }
+        trackTextureCreated(layer);
+    }
+    return SDL_SetRenderTarget(renderer, layer) == 0;
+}
+
+void SdlRenderBackend::endLayer() { SDL_SetRenderTarget(renderer, nullptr); }
+
+void SdlRenderBackend::drawLayer() {
+    if (layer) {
+        SDL_RenderCopy(renderer, layer, nullptr, nullptr);
+    }
+}
+
+void SdlRenderBackend::resetLayer() {
+    // デバイスが変わるとテクスチャ自体が使えないので、作り直しを許す
+    destroyLayer();
+    layerUnavailable = false;
+}
+
+void SdlRenderBackend::present() { SDL_RenderPresent(renderer); }
+
+bool SdlRenderBackend::readPixels(Uint32* pixels, int width, int height) {
+    // SDL2 には非同期の読み出しが無いので、描画の完了を待って読み出す
+    // （ダミーのビデオドライバのソフトウェアレンダラーではメモリのコピー）
+    SDL_Rect rect = {0, 0, width, height};
+    return SDL_RenderReadPixels(renderer, &rect, SDL_PIXELFORMAT_ARGB8888,
+                                pixels,
+                                width * static_cast<int>(sizeof(Uint32))) == 0;
+}
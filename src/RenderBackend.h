@@ -0,0 +1,75 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+// 描画の出力先
+//
+// Game は描画キューに積んだ三角形をこの窓口へ流し、SDL_Renderer を直接は
+// 呼ばない。実装は SDL_Renderer に任せる SdlRenderBackend と、CPU の
+// フレームバッファへ自前でラスタライズする SoftwareRasterizer の2つ
+// テクスチャの識別には SDL_Texture* をそのまま使う（描画キューの並べ替えや
+// SDL_QueryTexture でのサイズ取得がどちらの実装でも同じように動く）
+class RenderBackend {
+   public:
+    virtual ~RenderBackend() {}
+
+    // surface の画像からテクスチャを作る（surface は呼び出し側が解放する）
+    // アルファブレンドで描画する設定にして返す
+    virtual SDL_Texture* createTexture(SDL_Surface* surface) = 0;
+    virtual void destroyTexture(SDL_Texture* texture) = 0;
+
+    // 描画先全体を color で塗りつぶす
+    virtual void clear(SDL_Color color) = 0;
+
+    // 同じテクスチャ（nullptr なら単色）の三角形リストを描く
+    virtual void drawGeometry(SDL_Texture* texture, const SDL_Vertex* vertices,
+                              int vertexCount, const int* indices,
+                              int indexCount) = 0;
+
+    // 静的レイヤー（毎フレームコピーするだけの焼き込み済みの画面）
+    // beginLayer から endLayer までの描画をレイヤーへ向ける
+    // レイヤーを作れない環境では false を返し、描画先は変わらない
+    virtual bool beginLayer() = 0;
+    virtual void endLayer() = 0;
+    // 最後に描いたレイヤーを描画先全体にコピーする
+    virtual void drawLayer() = 0;
+    // レイヤーを捨て、次の beginLayer で作り直す（デバイスのリセット後）
+    virtual void resetLayer() = 0;
+
+    // 描いたフレームを画面に反映する
+    virtual void present() = 0;
+
+    // present 前のフレームの左上 width x height を ARGB で pixels に読み出す
+    // （1行 = width ピクセル）
+    virtual bool readPixels(Uint32* pixels, int width, int height) = 0;
+};
+
+// SDL_Renderer にそのまま描画する（GPU があれば GPU で描かれる）
+class SdlRenderBackend : public RenderBackend {
+   public:
+    SdlRenderBackend();
+    ~SdlRenderBackend();
+
+    void initialize(SDL_Renderer* renderer);
+    // レイヤーのテクスチャを解放する（レンダラーより先に呼ぶ）
+    void destroy();
+
+    SDL_Texture* createTexture(SDL_Surface* surface);
+    void destroyTexture(SDL_Texture* texture);
+    void clear(SDL_Color color);
+    void drawGeometry(SDL_Texture* texture, const SDL_Vertex* vertices,
+                      int vertexCount, const int* indices, int indexCount);
+    bool beginLayer();
+    void endLayer();
+    void drawLayer();
+    void resetLayer();
+    void present();
+    bool readPixels(Uint32* pixels, int width, int height);
+
+   private:
+    void destroyLayer();
+
+    SDL_Renderer* renderer;
+    SDL_Texture* layer;  // レンダーターゲット
+    // レイヤーを作れなかった（作り直しとログを毎フレーム繰り返さない）
+    bool layerUnavailable;
+};
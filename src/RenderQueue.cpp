@@ -0,0 +1,206 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+// 四角形1つ分の頂点番号（0-1-2 と 2-3-0 の2枚の三角形）
+static const int QUAD_INDICES[6] = {0, 1, 2, 2, 3, 0};
+
+RenderQueue::RenderQueue() : lastBatchCount(0) {
+    commands.reserve(RENDER_QUEUE_RESERVE_COMMANDS);
+    order.reserve(RENDER_QUEUE_RESERVE_COMMANDS);
+    vertices.reserve(RENDER_QUEUE_RESERVE_QUADS * 4);
+    batchVertices.reserve(RENDER_QUEUE_RESERVE_QUADS * 4);
+    indices.reserve(RENDER_QUEUE_RESERVE_QUADS * 6);
+    batchIndices.reserve(RENDER_QUEUE_RESERVE_QUADS * 6);
+}
+
+bool RenderQueue::CommandOrder::operator()(int a, int b) const {
+    const Command& ca = (*commands)[a];
+    const Command& cb = (*commands)[b];
+    if (ca.layer != cb.layer) {
+        return ca.layer < cb.layer;
+    }
+    if (ca.texture != cb.texture) {
+        return std::less<SDL_Texture*>()(ca.texture, cb.texture);
+    }
+    return ca.sequence < cb.sequence;
+}
+
+RenderQueue::Command& RenderQueue::pushCommand(SDL_Texture* texture,
+                                               int layer, int vertexCount,
+                                               int indexCount) {
+    Command command;
+    command.layer = layer;
+    command.texture = texture;
+    command.sequence = static_cast<int>(commands.size());
+    command.firstVertex = static_cast<int>(vertices.size());
+    command.vertexCount = vertexCount;
+    command.firstIndex = static_cast<int>(indices.size());
+    command.indexCount = indexCount;
+    commands.push_back(command);
+
+    vertices.resize(vertices.size() + vertexCount);
+    indices.resize(indices.size() + indexCount);
+    return commands.back();
+}
+
+SDL_Vertex* RenderQueue::addQuads(SDL_Texture* texture, int quadCount,
+                                  int layer) {
+    Command& command =
+        pushCommand(texture, layer, quadCount * 4, quadCount * 6);
+    int* idx = &indices[command.firstIndex];
+    for (int q = 0; q < quadCount; q++) {
+        for (int k = 0; k < 6; k++) {
+            idx[q * 6 + k] = q * 4 + QUAD_INDICES[k];
+        }
+    }
+    return &vertices[command.firstVertex];
+}
+
+void RenderQueue::addTriangles(SDL_Texture* texture,
+                               const SDL_Vertex* triangleVertices,
+                               int vertexCount, const int* triangleIndices,
+                               int indexCount, int layer) {
+    if (vertexCount <= 0 || indexCount <= 0) {
+        return;
+    }
+    Command& command = pushCommand(texture, layer, vertexCount, indexCount);
+    std::copy(triangleVertices, triangleVertices + vertexCount,
+              &vertices[command.firstVertex]);
+    std::copy(triangleIndices, triangleIndices + indexCount,
+              &indices[command.firstIndex]);
+}
+
+void RenderQueue::addRect(const SDL_Rect& rect, SDL_Color color, int layer) {
+    if (rect.w <= 0 || rect.h <= 0) {
+        return;
+    }
+    float x0 = static_cast<float>(rect.x);
+    float y0 = static_cast<float>(rect.y);
+    float x1 = x0 + rect.w;
+    float y1 = y0 + rect.h;
+
+    SDL_Vertex* v = addQuads(nullptr, 1, layer);
+    v[0] = {{x0, y0}, color, {0.0f, 0.0f}};
+    v[1] = {{x1, y0}, color, {0.0f, 0.0f}};
+    v[2] = {{x1, y1}, color, {0.0f, 0.0f}};
+    v[3] = {{x0, y1}, color, {0.0f, 0.0f}};
+}
+
+void RenderQueue::addRectOutline(const SDL_Rect& rect, SDL_Color color,
+                                 int layer) {
+    if (rect.w <= 0 || rect.h <= 0) {
+        return;
+    }
+    // 上下の辺は全幅、左右の辺は上下の辺と重ならない部分だけ
+    SDL_Rect top = {rect.x, rect.y, rect.w, 1};
+    SDL_Rect bottom = {rect.x, rect.y + rect.h - 1, rect.w, 1};
+    SDL_Rect left = {rect.x, rect.y + 1, 1, rect.h - 2};
+    SDL_Rect right = {rect.x + rect.w - 1, rect.y + 1, 1, rect.h - 2};
+    addRect(top, color, layer);
+    if (rect.h > 1) {
+        addRect(bottom, color, layer);
+    }
+    addRect(left, color, layer);
+    if (rect.w > 1) {
+        addRect(right, color, layer);
+    }
+}
+
+void RenderQueue::addLine(float x0, float y0, float x1, float y1,
+                          SDL_Color color, int layer, float width) {
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length <= 0.0f) {
+        return;
+    }
+    // 線分に垂直な方向へ太さの半分ずつ広げた四角形
+    float nx = -dy / length * width * 0.5f;
+    float ny = dx / length * width * 0.5f;
+
+    SDL_Vertex* v = addQuads(nullptr, 1, layer);
+    v[0] = {{x0 + nx, y0 + ny}, color, {0.0f, 0.0f}};
+    v[1] = {{x1 + nx, y1 + ny}, color, {0.0f, 0.0f}};
+    v[2] = {{x1 - nx, y1 - ny}, color, {0.0f, 0.0f}};
+    v[3] = {{x0 - nx, y0 - ny}, color, {0.0f, 0.0f}};
+}
+
+void RenderQueue::addSprite(SDL_Texture* texture, const SDL_Rect& src,
+                            const SDL_FRect& dst, SDL_Color color,
+                            int layer) {
+    int textureW, textureH;
+    if (!texture ||
+        SDL_QueryTexture(texture, nullptr, nullptr, &textureW, &textureH) !=
+            0) {
+        return;
+    }
+    float u0 = static_cast<float>(src.x) / textureW;
+    float v0 = static_cast<float>(src.y) / textureH;
+    float u1 = static_cast<float>(src.x + src.w) / textureW;
+    float v1 = static_cast<float>(src.y + src.h) / textureH;
+    float x1 = dst.x + dst.w;
+    float y1 = dst.y + dst.h;
+
+    SDL_Vertex* v = addQuads(texture, 1, layer);
+    v[0] = {{dst.x, dst.y}, color, {u0, v0}};
+    v[1] = {{x1, dst.y}, color, {u1, v0}};
+    v[2] = {{x1, y1}, color, {u1, v1}};
+    v[3] = {{dst.x, y1}, color, {u0, v1}};
+}
+
+int RenderQueue::flush(RenderBackend& backend) {
+    // レイヤー → テクスチャ → 追加順 に並べる
+    order.resize(commands.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = static_cast<int>(i);
+    }
+    CommandOrder less = {&commands};
+    std::sort(order.begin(), order.end(), less);
+
+    // 同じテクスチャが続く間は1つのバッファに連結する
+    int batches = 0;
+    SDL_Texture* batchTexture = nullptr;
+    batchVertices.clear();
+    batchIndices.clear();
+    for (size_t i = 0; i < order.size(); i++) {
+        const Command& command = commands[order[i]];
+        if (command.texture != batchTexture && !batchIndices.empty()) {
+            backend.drawGeometry(batchTexture, batchVertices.data(),
+                                 static_cast<int>(batchVertices.size()),
+                                 batchIndices.data(),
+                                 static_cast<int>(batchIndices.size()));
+            batches++;
+            batchVertices.clear();
+            batchIndices.clear();
+        }
+        batchTexture = command.texture;
+
+        int base = static_cast<int>(batchVertices.size());
+        batchVertices.insert(
+            batchVertices.end(), vertices.begin() + command.firstVertex,
+            vertices.begin() + command.firstVertex + command.vertexCount);
+        for (int k = 0; k < command.indexCount; k++) {
+            batchIndices.push_back(base + indices[command.firstIndex + k]);
+        }
+    }
+    if (!batchIndices.empty()) {
+        backend.drawGeometry(batchTexture, batchVertices.data(),
+                             static_cast<int>(batchVertices.size()),
+                             batchIndices.data(),
+                             static_cast<int>(batchIndices.size()));
+        batches++;
+    }
+
+    clear();
+    lastBatchCount = batches;
+    return batches;
+}
+
+void RenderQueue::clear() {
+    commands.clear();
+    vertices.clear();
+    indices.clear();
+}
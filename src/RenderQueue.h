@@ -0,0 +1,96 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+#include <vector>
+
+#include "RenderBackend.h"
+
+// 描画の重なり順（小さいほど奥）
+// 同じレイヤーの中ではテクスチャごとにまとめ直すので、
+// 重なり合うものは同じテクスチャ（または単色）で描くこと
+enum RenderLayer {
+    LAYER_WORLD,   // 壁
+    LAYER_HUD,     // ゲージ・指示枠
+    LAYER_PLAYER,  // プレイヤー
+    LAYER_TEXT,    // スコア・メッセージ・オーバーレイの文字
+    LAYER_COUNT
+};
+
+// 1フレーム分の描画を溜めておき、最後にまとめて送る描画キュー
+//
+// 矩形・線・スプライトはすべて三角形として溜め、flush() でレイヤーと
+// テクスチャの順に並べ替えてから、テクスチャが変わるところだけで
+// 描画バックエンドへ送る（SDL_Renderer なら SDL_RenderGeometry）。
+// 単色の図形は1回の呼び出しにまとまるので、HUD の要素や壁が増えても
+// 呼び出し回数は増えない
+// バッファはフレームをまたいで再利用し、1フレーム分を最初から確保しておく
+// （定常状態のフレームでヒープ確保をしない）
+const int RENDER_QUEUE_RESERVE_COMMANDS = 256;
+const int RENDER_QUEUE_RESERVE_QUADS = 2048;
+
+class RenderQueue {
+   public:
+    RenderQueue();
+
+    // 塗りつぶした矩形
+    void addRect(const SDL_Rect& rect, SDL_Color color, int layer);
+
+    // 1ピクセル幅の矩形の枠（SDL_RenderDrawRect と同じピクセル）
+    void addRectOutline(const SDL_Rect& rect, SDL_Color color, int layer);
+
+    // 太さ width の線分
+    void addLine(float x0, float y0, float x1, float y1, SDL_Color color,
+                 int layer, float width = 1.0f);
+
+    // テクスチャの src（ピクセル座標）を dst に貼る。色は乗算される
+    void addSprite(SDL_Texture* texture, const SDL_Rect& src,
+                   const SDL_FRect& dst, SDL_Color color, int layer);
+
+    // quadCount 個の四角形（1つにつき頂点4つ、時計回り）を追加し、
+    // 呼び出し側が埋める頂点の先頭を返す（次に追加するまで有効）
+    SDL_Vertex* addQuads(SDL_Texture* texture, int quadCount, int layer);
+
+    // 任意の三角形リストを追加する（triangleIndices は頂点の番号）
+    void addTriangles(SDL_Texture* texture,
+                      const SDL_Vertex* triangleVertices, int vertexCount,
+                      const int* triangleIndices, int indexCount, int layer);
+
+    // 溜めた描画をバックエンドへ送り、キューを空にする
+    // 戻り値は drawGeometry を呼んだ回数
+    int flush(RenderBackend& backend);
+
+    // 溜めずに捨てる
+    void clear();
+
+    int getCommandCount() const { return static_cast<int>(commands.size()); }
+    int getLastBatchCount() const { return lastBatchCount; }
+
+   private:
+    // 1回の add で追加された三角形のまとまり
+    struct Command {
+        int layer;
+        SDL_Texture* texture;
+        int sequence;  // 追加順（同じレイヤー・テクスチャ内の順序を保つ）
+        int firstVertex, vertexCount;
+        int firstIndex, indexCount;
+    };
+
+    struct CommandOrder {
+        const std::vector<Command>* commands;
+        bool operator()(int a, int b) const;
+    };
+
+    Command& pushCommand(SDL_Texture* texture, int layer, int vertexCount,
+                         int indexCount);
+
+    std::vector<Command> commands;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+
+    // flush 時の並べ替え結果と、テクスチャごとにまとめた送信用バッファ
+    std::vector<int> order;
+    std::vector<SDL_Vertex> batchVertices;
+    std::vector<int> batchIndices;
+
+    int lastBatchCount;
+};
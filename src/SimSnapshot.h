@@ -0,0 +1,69 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+#include "core/Simulation.h"
+
+// 受け付けた入力の遅延計測用の時刻（シミュレーション側で記録し、
+// 描画側で LatencyProbe に渡す）
+struct InputLatencyStamp {
+    Uint32 serial;  // 受け付けた入力の通し番号（0 なら無し）
+    Uint32 eventTimestamp;
+    Uint32 pollTicks;
+    Uint64 pollCounter;    // 入力キューから取り出した
+    Uint64 applyCounter;   // シミュレーションへ渡した
+    Uint64 updateCounter;  // そのティックの更新完了
+
+    InputLatencyStamp()
+        : serial(0),
+          eventTimestamp(0),
+          pollTicks(0),
+          pollCounter(0),
+          applyCounter(0),
+          updateCounter(0) {}
+};
+
+// シミュレーションが毎ティック公開する、描画に必要な状態の写し
+// 公開後は書き換えないので、描画側はロックなしで読める
+struct SimSnapshot {
+    GameState gameState;
+    Uint32 now;
+    Uint32 gameOverTime;
+    int score;
+    int currentTime;
+    int currentMaxTime;
+    RoundDescriptor round;
+
+    // ティック終了時とティック開始時（補間用）のプレイヤー位置
+    float playerX, playerY;
+    float prevPlayerX, prevPlayerY;
+    bool playerMoving;
+
+    // このティックの終わりに当たる実時間（高精度カウンタ）
+    Uint64 tickCounter;
+    // このティックの更新にかかった時間（マイクロ秒、監視用）
+    Uint32 updateMicros;
+
+    InputLatencyStamp latency;
+
+    SimSnapshot()
+        : gameState(STATE_COUNTDOWN),
+          now(0),
+          gameOverTime(0),
+          score(0),
+          currentTime(INITIAL_MAX_TIME),
+          currentMaxTime(INITIAL_MAX_TIME),
+          round(0),
+          playerX(0),
+          playerY(0),
+          prevPlayerX(0),
+          prevPlayerY(0),
+          playerMoving(false),
+          tickCounter(0),
+          updateMicros(0) {}
+
+    // isSessionFinished(SimState) と同じ判定
+    bool isSessionFinished() const {
+        return gameState == STATE_GAMEOVER &&
+               now - gameOverTime >= GAMEOVER_HOLD_TIME;
+    }
+};
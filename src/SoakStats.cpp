@@ -0,0 +1,106 @@
+#include "SoakStats.h"
+
+#include <cstring>
+
+#include "MemoryTelemetry.h"
+
+void SoakStats::Histogram::clear() {
+    memset(bins, 0, sizeof(bins));
+    count = 0;
+    maxUs = 0;
+}
+
+void SoakStats::Histogram::add(Uint64 us) {
+    Uint64 bin = us / SOAK_HISTOGRAM_STEP_US;
+    if (bin >= static_cast<Uint64>(SOAK_HISTOGRAM_BINS)) {
+        bin = SOAK_HISTOGRAM_BINS - 1;
+    }
+    bins[bin]++;
+    count++;
+    maxUs = us > maxUs ? us : maxUs;
+}
+
+double SoakStats::Histogram::percentile(double p) const {
+    if (count == 0) {
+        return 0.0;
+    }
+    // 小さい方から数えて count * p 個目を含む区間
+    Uint64 rank = static_cast<Uint64>(count * p);
+    if (rank >= count) {
+        rank = count - 1;
+    }
+    Uint64 seen = 0;
+    for (int i = 0; i < SOAK_HISTOGRAM_BINS; i++) {
+        seen += bins[i];
+        if (seen > rank) {
+            return (i + 1) * SOAK_HISTOGRAM_STEP_US / 1000.0;
+        }
+    }
+    return maxUs / 1000.0;
+}
+
+SoakStats::SoakStats() { start(0); }
+
+void SoakStats::start(Uint32 now) {
+    startTime = now;
+    windowStart = now;
+    lastCounter = 0;
+    frequency = SDL_GetPerformanceFrequency();
+    windowFrames.clear();
+    totalFrames.clear();
+    windowSessions = totalSessions = 0;
+    windowBestScore = bestScore = 0;
+    lastScore = 0;
+    startRss = getResidentMemory();
+}
+
+void SoakStats::addFrame(Uint64 counter) {
+    if (lastCounter != 0 && counter > lastCounter) {
+        Uint64 us = (counter - lastCounter) * 1000000 / frequency;
+        windowFrames.add(us);
+        totalFrames.add(us);
+    }
+    lastCounter = counter;
+}
+
+void SoakStats::addSession(int score) {
+    windowSessions++;
+    totalSessions++;
+    lastScore = score;
+    windowBestScore = score > windowBestScore ? score : windowBestScore;
+    bestScore = score > bestScore ? score : bestScore;
+}
+
+void SoakStats::reportWindow(Uint32 now) {
+    logStats("Soak", now, windowStart, windowFrames, windowSessions,
+             windowBestScore);
+    windowStart = now;
+    windowFrames.clear();
+    windowSessions = 0;
+    windowBestScore = 0;
+}
+
+void SoakStats::reportTotal(Uint32 now) const {
+    logStats("Soak total", now, startTime, totalFrames, totalSessions,
+             bestScore);
+}
+
+void SoakStats::logStats(const char* label, Uint32 now, Uint32 since,
+                         const Histogram& frames, int sessions,
+                         int best) const {
+    Uint32 elapsed = (now - startTime) / 1000;
+    double seconds = (now - since) / 1000.0;
+    double fps = seconds > 0.0 ? frames.count / seconds : 0.0;
+
+    // RSS の増加（開始時との差、MB）
+    double rssMb = getResidentMemory() / (1024.0 * 1024.0);
+    double growthMb = rssMb - startRss / (1024.0 * 1024.0);
+
+    SDL_Log("%s %02u:%02u:%02u: %.1f fps, frame p50 %.1f p95 %.1f p99 %.1f "
+            "max %.1f ms, %d sessions (last %d, best %d), "
+            "RSS %.1f MB (%+.1f MB)",
+            label, elapsed / 3600, elapsed / 60 % 60, elapsed % 60, fps,
+            frames.percentile(0.50), frames.percentile(0.95),
+            frames.percentile(0.99), frames.maxUs / 1000.0, sessions,
+            lastScore, best, rssMb, growthMb);
+}
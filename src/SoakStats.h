@@ -0,0 +1,69 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+// フレーム時間のヒストグラムの刻み（マイクロ秒）と区間の数
+// 0.1 ミリ秒刻みで 100 ミリ秒まで。それより長いフレームは最後の区間に入れる
+const int SOAK_HISTOGRAM_STEP_US = 100;
+const int SOAK_HISTOGRAM_BINS = 1000;
+
+// 途中経過を出す間隔（ミリ秒）
+const Uint32 SOAK_REPORT_INTERVAL = 60000;
+
+// 自動プレイヤーでの長時間実行（--bot / --soak）の計測
+//
+// フレーム時間（描画の開始から次の描画の開始まで）のヒストグラムから
+// パーセンタイルを求め、FPS・セッション数・スコア・常駐メモリ（RSS）の
+// 増え方と合わせて一定間隔でログに出す。ヒストグラムは固定長の配列で、
+// 計測中にヒープを確保しない
+class SoakStats {
+   public:
+    SoakStats();
+
+    // 計測を開始する（now: SDL_GetTicks）
+    void start(Uint32 now);
+
+    // 1フレーム描画した（counter: SDL_GetPerformanceCounter）
+    void addFrame(Uint64 counter);
+
+    // 1セッションが終わった
+    void addSession(int score);
+
+    // 開始からの経過時間（ミリ秒）
+    Uint32 getElapsed(Uint32 now) const { return now - startTime; }
+
+    // 途中経過を出す時刻か
+    bool isReportDue(Uint32 now) const {
+        return now - windowStart >= SOAK_REPORT_INTERVAL;
+    }
+    // 直近の区間の値をログに出し、次の区間へ進む
+    void reportWindow(Uint32 now);
+    // 開始からの全体の値をログに出す
+    void reportTotal(Uint32 now) const;
+
+   private:
+    struct Histogram {
+        Uint32 bins[SOAK_HISTOGRAM_BINS];
+        Uint64 count;
+        Uint64 maxUs;
+
+        void clear();
+        void add(Uint64 us);
+        // p（0〜1）のパーセンタイル（ミリ秒、区間の上端）
+        double percentile(double p) const;
+    };
+
+    void logStats(const char* label, Uint32 now, Uint32 since,
+                  const Histogram& frames, int sessions, int best) const;
+
+    Uint32 startTime;
+    Uint32 windowStart;
+    Uint64 lastCounter;  // 直前のフレームの時刻（0なら未計測）
+    Uint64 frequency;
+
+    Histogram windowFrames, totalFrames;
+    int windowSessions, totalSessions;
+    int windowBestScore, bestScore;
+    int lastScore;
+
+    size_t startRss;
+};
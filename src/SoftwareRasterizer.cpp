@@ -0,0 +1,566 @@
+#include "SoftwareRasterizer.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "MemoryTelemetry.h"
+#include "PpmImage.h"
+#include "ProfileZones.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#define SOFTWARE_RASTERIZER_SSE2 1
+#endif
+
+// テクスチャを貼る行を何ピクセルずつ読み出してブレンドするか
+static const int SPAN_CHUNK = 64;
+
+static const Uint32 OPAQUE_ALPHA = 0xFF000000u;
+
+static Uint32 packColor(SDL_Color color) {
+    return (static_cast<Uint32>(color.a) << 24) |
+           (static_cast<Uint32>(color.r) << 16) |
+           (static_cast<Uint32>(color.g) << 8) | color.b;
+}
+
+static bool sameColor(SDL_Color a, SDL_Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+// テクセルの番号を [0, size) に収める
+static inline int clampIndex(int index, int size) {
+    return index < 0 ? 0 : (index >= size ? size - 1 : index);
+}
+
+// x / 255 を丸めて求める（x は 255 * 255 まで）
+static inline Uint32 div255(Uint32 x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// ---- 1ピクセル（スカラー） ----
+
+// 各チャンネルに color を乗算する
+static inline Uint32 modulatePixel(Uint32 texel, Uint32 color) {
+    Uint32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        out |= div255(((texel >> shift) & 0xFF) * ((color >> shift) & 0xFF))
+               << shift;
+    }
+    return out;
+}
+
+// src（アルファは乗算前）を dst に重ねる。画面は常に不透明
+static inline Uint32 blendPixel(Uint32 src, Uint32 dst) {
+    Uint32 a = src >> 24;
+    Uint32 out = OPAQUE_ALPHA;
+    for (int shift = 0; shift < 24; shift += 8) {
+        Uint32 s = (src >> shift) & 0xFF;
+        Uint32 d = (dst >> shift) & 0xFF;
+        out |= div255(s * a + d * (255 - a)) << shift;
+    }
+    return out;
+}
+
+// ---- 1行分 ----
+// SSE2 では4ピクセルずつ処理し、端数はスカラーで処理する
+// （どちらも同じ式なので結果はビット単位で一致する）
+
+#ifdef SOFTWARE_RASTERIZER_SSE2
+
+// 16ビットの各レーンの x / 255 を丸めて求める
+static inline __m128i div255x8(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// 2ピクセル分（16ビット×8レーン）の各ピクセルのアルファを4レーンに広げる
+static inline __m128i broadcastAlpha(__m128i pixels) {
+    pixels = _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm_shufflehi_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+static inline __m128i blendHalf(__m128i src, __m128i dst) {
+    __m128i alpha = broadcastAlpha(src);
+    __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+    return div255x8(_mm_add_epi16(_mm_mullo_epi16(src, alpha),
+                                  _mm_mullo_epi16(dst, inverse)));
+}
+
+// 4ピクセルの blendPixel
+static inline __m128i blend4(__m128i src, __m128i dst) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = blendHalf(_mm_unpacklo_epi8(src, zero),
+                           _mm_unpacklo_epi8(dst, zero));
+    __m128i hi = blendHalf(_mm_unpackhi_epi8(src, zero),
+                           _mm_unpackhi_epi8(dst, zero));
+    return _mm_or_si128(_mm_packus_epi16(lo, hi),
+                        _mm_set1_epi32(static_cast<int>(OPAQUE_ALPHA)));
+}
+
+// 4ピクセルの modulatePixel（color は16ビットに広げた1ピクセル分×2）
+static inline __m128i modulate4(__m128i texels, __m128i color) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = div255x8(
+        _mm_mullo_epi16(_mm_unpacklo_epi8(texels, zero), color));
+    __m128i hi = div255x8(
+        _mm_mullo_epi16(_mm_unpackhi_epi8(texels, zero), color));
+    return _mm_packus_epi16(lo, hi);
+}
+
+#endif
+
+// dst の count ピクセルを color で埋める
+static void fillSpan(Uint32* dst, int count, Uint32 color) {
+    int i = 0;
+#ifdef SOFTWARE_RASTERIZER_SSE2
+    __m128i value = _mm_set1_epi32(static_cast<int>(color));
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), value);
+    }
+#endif
+    for (; i < count; i++) {
+        dst[i] = color;
+    }
+}
+
+// dst の count ピクセルに半透明の color を重ねる
+static void blendSpan(Uint32* dst, int count, Uint32 color) {
+    int i = 0;
+#ifdef SOFTWARE_RASTERIZER_SSE2
+    __m128i src = _mm_set1_epi32(static_cast<int>(color));
+    for (; i + 4 <= count; i += 4) {
+        __m128i* p = reinterpret_cast<__m128i*>(dst + i);
+        _mm_storeu_si128(p, blend4(src, _mm_loadu_si128(p)));
+    }
+#endif
+    for (; i < count; i++) {
+        dst[i] = blendPixel(color, dst[i]);
+    }
+}
+
+// dst の count ピクセルに、color を乗算した texels を重ねる
+static void blendTexelSpan(Uint32* dst, const Uint32* texels, int count,
+                           Uint32 color) {
+    bool modulate = color != 0xFFFFFFFFu;
+    int i = 0;
+#ifdef SOFTWARE_RASTERIZER_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    __m128i color16 = _mm_unpacklo_epi8(
+        _mm_set1_epi32(static_cast<int>(color)), zero);
+    for (; i + 4 <= count; i += 4) {
+        __m128i src =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(texels + i));
+        if (modulate) {
+            src = modulate4(src, color16);
+        }
+        __m128i* p = reinterpret_cast<__m128i*>(dst + i);
+        _mm_storeu_si128(p, blend4(src, _mm_loadu_si128(p)));
+    }
+#endif
+    for (; i < count; i++) {
+        Uint32 src = modulate ? modulatePixel(texels[i], color) : texels[i];
+        dst[i] = blendPixel(src, dst[i]);
+    }
+}
+
+// ---- SoftwareRasterizer ----
+
+SoftwareRasterizer::SoftwareRasterizer()
+    : renderer(nullptr),
+      screen(nullptr),
+      width(0),
+      height(0),
+      layerReady(false),
+      target(nullptr) {}
+
+SoftwareRasterizer::~SoftwareRasterizer() { destroy(); }
+
+bool SoftwareRasterizer::initialize(SDL_Renderer* renderer, int width,
+                                    int height) {
+    destroy();
+    if (!renderer || width <= 0 || height <= 0) {
+        return false;
+    }
+    this->renderer = renderer;
+    this->width = width;
+    this->height = height;
+    frame.assign(static_cast<size_t>(width) * height, OPAQUE_ALPHA);
+    target = frame.data();
+
+    screen = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                               SDL_TEXTUREACCESS_STREAMING, width, height);
+    if (!screen) {
+        SDL_Log("SDL_CreateTexture Error: %s", SDL_GetError());
+        return false;
+    }
+    trackTextureCreated(screen);
+    return true;
+}
+
+void SoftwareRasterizer::destroy() {
+    for (size_t i = 0; i < textures.size(); i++) {
+        trackTextureDestroyed(textures[i].handle);
+        SDL_DestroyTexture(textures[i].handle);
+    }
+    textures.clear();
+    if (screen) {
+        trackTextureDestroyed(screen);
+        SDL_DestroyTexture(screen);
+        screen = nullptr;
+    }
+    renderer = nullptr;
+    layerReady = false;
+}
+
+SDL_Texture* SoftwareRasterizer::createTexture(SDL_Surface* surface) {
+    if (!renderer || !surface) {
+        return nullptr;
+    }
+    // 描画キュー上の識別とサイズの問い合わせ用に、レンダラー側にも作る
+    SDL_Texture* handle = SDL_CreateTextureFromSurface(renderer, surface);
+    if (!handle) {
+        SDL_Log("SDL_CreateTextureFromSurface Error: %s", SDL_GetError());
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(handle, SDL_BLENDMODE_BLEND);
+
+    SDL_Surface* argb =
+        SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (!argb) {
+        SDL_Log("SDL_ConvertSurfaceFormat Error: %s", SDL_GetError());
+        SDL_DestroyTexture(handle);
+        return nullptr;
+    }
+    Texture texture;
+    texture.handle = handle;
+    texture.width = argb->w;
+    texture.height = argb->h;
+    texture.pixels.resize(static_cast<size_t>(argb->w) * argb->h);
+    SDL_LockSurface(argb);
+    for (int y = 0; y < argb->h; y++) {
+        memcpy(&texture.pixels[static_cast<size_t>(y) * argb->w],
+               static_cast<Uint8*>(argb->pixels) + y * argb->pitch,
+               argb->w * sizeof(Uint32));
+    }
+    SDL_UnlockSurface(argb);
+    SDL_FreeSurface(argb);
+
+    textures.push_back(texture);
+    trackTextureCreated(handle);
+    return handle;
+}
+
+void SoftwareRasterizer::destroyTexture(SDL_Texture* texture) {
+    for (size_t i = 0; i < textures.size(); i++) {
+        if (textures[i].handle == texture) {
+            trackTextureDestroyed(texture);
+            SDL_DestroyTexture(texture);
+            textures.erase(textures.begin() + i);
+            return;
+        }
+    }
+}
+
+const SoftwareRasterizer::Texture* SoftwareRasterizer::findTexture(
+    SDL_Texture* handle) const {
+    for (size_t i = 0; i < textures.size(); i++) {
+        if (textures[i].handle == handle) {
+            return &textures[i];
+        }
+    }
+    return nullptr;
+}
+
+void SoftwareRasterizer::clear(SDL_Color color) {
+    fillSpan(target, width * height, packColor(color) | OPAQUE_ALPHA);
+}
+
+void SoftwareRasterizer::drawGeometry(SDL_Texture* texture,
+                                      const SDL_Vertex* vertices,
+                                      int vertexCount, const int* indices,
+                                      int indexCount) {
+    PROFILE_ZONE("SoftwareRasterizer::drawGeometry");
+    const Texture* cpuTexture = nullptr;
+    if (texture) {
+        cpuTexture = findTexture(texture);
+        if (!cpuTexture) {
+            return;  // 別のバックエンドで作られたテクスチャ
+        }
+    }
+
+    // SDL_RenderGeometry と同じく、範囲外の頂点番号があれば描かない
+    for (int k = 0; k < indexCount; k++) {
+        if (indices[k] < 0 || indices[k] >= vertexCount) {
+            return;
+        }
+    }
+
+    int i = 0;
+    while (i + 3 <= indexCount) {
+        // 描画キューの四角形（0-1-2, 2-3-0）はまとめて1つの矩形として描く
+        const int* t = indices + i;
+        if (i + 6 <= indexCount && drawQuad(cpuTexture, vertices, t)) {
+            i += 6;
+            continue;
+        }
+        drawTriangle(cpuTexture, vertices[t[0]], vertices[t[1]],
+                     vertices[t[2]]);
+        i += 3;
+    }
+}
+
+bool SoftwareRasterizer::drawQuad(const Texture* texture,
+                                  const SDL_Vertex* vertices,
+                                  const int* quad) {
+    if (quad[3] != quad[2] || quad[5] != quad[0]) {
+        return false;
+    }
+    const SDL_Vertex& a = vertices[quad[0]];
+    const SDL_Vertex& b = vertices[quad[1]];
+    const SDL_Vertex& c = vertices[quad[2]];
+    const SDL_Vertex& d = vertices[quad[4]];
+
+    // 左上から時計回りの、軸に平行で単色の四角形だけを扱う
+    if (a.position.y != b.position.y || b.position.x != c.position.x ||
+        c.position.y != d.position.y || d.position.x != a.position.x ||
+        a.position.x >= c.position.x || a.position.y >= c.position.y) {
+        return false;
+    }
+    if (!sameColor(a.color, b.color) || !sameColor(a.color, c.color) ||
+        !sameColor(a.color, d.color)) {
+        return false;
+    }
+    if (texture && (a.tex_coord.y != b.tex_coord.y ||
+                    b.tex_coord.x != c.tex_coord.x ||
+                    c.tex_coord.y != d.tex_coord.y ||
+                    d.tex_coord.x != a.tex_coord.x)) {
+        return false;
+    }
+
+    // 中心が [x0, x1) x [y0, y1) に入るピクセル
+    float x0 = a.position.x, y0 = a.position.y;
+    float x1 = c.position.x, y1 = c.position.y;
+    int left = static_cast<int>(std::ceil(x0 - 0.5f));
+    int top = static_cast<int>(std::ceil(y0 - 0.5f));
+    int right = static_cast<int>(std::ceil(x1 - 0.5f));
+    int bottom = static_cast<int>(std::ceil(y1 - 0.5f));
+    int clipLeft = left < 0 ? 0 : left;
+    int clipTop = top < 0 ? 0 : top;
+    if (right > width) {
+        right = width;
+    }
+    if (bottom > height) {
+        bottom = height;
+    }
+    int count = right - clipLeft;
+    if (count <= 0 || bottom <= clipTop) {
+        return true;
+    }
+
+    Uint32 color = packColor(a.color);
+    if (!texture) {
+        for (int y = clipTop; y < bottom; y++) {
+            Uint32* row = target + static_cast<size_t>(y) * width + clipLeft;
+            if (a.color.a == 255) {
+                fillSpan(row, count, color);
+            } else if (a.color.a > 0) {
+                blendSpan(row, count, color);
+            }
+        }
+        return true;
+    }
+
+    // テクスチャ座標はピクセルの中心で最も近いテクセルを取る
+    float texW = static_cast<float>(texture->width);
+    float texH = static_cast<float>(texture->height);
+    float stepU = (c.tex_coord.x - a.tex_coord.x) * texW / (x1 - x0);
+    float stepV = (c.tex_coord.y - a.tex_coord.y) * texH / (y1 - y0);
+    float startU = a.tex_coord.x * texW + (clipLeft + 0.5f - x0) * stepU;
+    float startV = a.tex_coord.y * texH + (clipTop + 0.5f - y0) * stepV;
+    Uint32 texels[SPAN_CHUNK];
+    for (int y = clipTop; y < bottom; y++) {
+        int ty = static_cast<int>(startV + (y - clipTop) * stepV);
+        if (ty < 0 || ty >= texture->height) {
+            continue;
+        }
+        const Uint32* source =
+            &texture->pixels[static_cast<size_t>(ty) * texture->width];
+        Uint32* row = target + static_cast<size_t>(y) * width + clipLeft;
+        for (int x = 0; x < count; x += SPAN_CHUNK) {
+            int n = count - x < SPAN_CHUNK ? count - x : SPAN_CHUNK;
+            for (int k = 0; k < n; k++) {
+                int tx = static_cast<int>(startU + (x + k) * stepU);
+                texels[k] = source[clampIndex(tx, texture->width)];
+            }
+            blendTexelSpan(row + x, texels, n, color);
+        }
+    }
+    return true;
+}
+
+// p0 → p1 の辺に対する p の位置（三角形の内側で正になる向きにそろえて使う）
+static float edgeFunction(const SDL_FPoint& p0, const SDL_FPoint& p1,
+                          float x, float y) {
+    return (x - p0.x) * (p1.y - p0.y) - (y - p0.y) * (p1.x - p0.x);
+}
+
+void SoftwareRasterizer::drawTriangle(const Texture* texture,
+                                      const SDL_Vertex& a,
+                                      const SDL_Vertex& b0,
+                                      const SDL_Vertex& c0) {
+    // a → b → c の向きにかかわらず内側が正になるようにする
+    float area = edgeFunction(a.position, b0.position, c0.position.x,
+                              c0.position.y);
+    if (area == 0.0f) {
+        return;
+    }
+    const SDL_Vertex& b = area > 0.0f ? b0 : c0;
+    const SDL_Vertex& c = area > 0.0f ? c0 : b0;
+    if (area < 0.0f) {
+        area = -area;
+    }
+    const SDL_Vertex* corners[3] = {&a, &b, &c};
+
+    float minY = std::fmin(a.position.y, std::fmin(b.position.y, c.position.y));
+    float maxY = std::fmax(a.position.y, std::fmax(b.position.y, c.position.y));
+    int top = static_cast<int>(std::ceil(minY - 0.5f));
+    int bottom = static_cast<int>(std::ceil(maxY - 0.5f));
+    top = top < 0 ? 0 : top;
+    bottom = bottom > height ? height : bottom;
+
+    // 単色の三角形は行ごとに塗りつぶす。それ以外はピクセルごとに補間する
+    bool uniform = !texture && sameColor(a.color, b.color) &&
+                   sameColor(a.color, c.color);
+    Uint32 uniformColor = packColor(a.color);
+
+    for (int y = top; y < bottom; y++) {
+        float py = y + 0.5f;
+        // 3辺それぞれの「内側」を満たす x の範囲を重ねる
+        float lo = 0.0f;
+        float hi = static_cast<float>(width);
+        bool empty = false;
+        for (int e = 0; e < 3 && !empty; e++) {
+            const SDL_FPoint& p0 = corners[(e + 1) % 3]->position;
+            const SDL_FPoint& p1 = corners[(e + 2) % 3]->position;
+            float slope = p1.y - p0.y;
+            float offset = edgeFunction(p0, p1, 0.0f, py);
+            if (slope > 0.0f) {
+                lo = std::fmax(lo, -offset / slope);
+            } else if (slope < 0.0f) {
+                hi = std::fmin(hi, -offset / slope);
+            } else if (offset < 0.0f) {
+                empty = true;
+            }
+        }
+        int left = static_cast<int>(std::ceil(lo - 0.5f));
+        int right = static_cast<int>(std::floor(hi - 0.5f)) + 1;
+        left = left < 0 ? 0 : left;
+        right = right > width ? width : right;
+        if (empty || right <= left) {
+            continue;
+        }
+
+        Uint32* row = target + static_cast<size_t>(y) * width;
+        if (uniform) {
+            if (a.color.a == 255) {
+                fillSpan(row + left, right - left, uniformColor);
+            } else if (a.color.a > 0) {
+                blendSpan(row + left, right - left, uniformColor);
+            }
+            continue;
+        }
+        for (int x = left; x < right; x++) {
+            float px = x + 0.5f;
+            float w[3];
+            for (int e = 0; e < 3; e++) {
+                w[e] = edgeFunction(corners[(e + 1) % 3]->position,
+                                    corners[(e + 2) % 3]->position, px, py) /
+                       area;
+            }
+            float r = 0.0f, g = 0.0f, bl = 0.0f, al = 0.0f;
+            float u = 0.0f, v = 0.0f;
+            for (int e = 0; e < 3; e++) {
+                const SDL_Vertex& corner = *corners[e];
+                r += w[e] * corner.color.r;
+                g += w[e] * corner.color.g;
+                bl += w[e] * corner.color.b;
+                al += w[e] * corner.color.a;
+                u += w[e] * corner.tex_coord.x;
+                v += w[e] * corner.tex_coord.y;
+            }
+            SDL_Color shade = {static_cast<Uint8>(r + 0.5f),
+                               static_cast<Uint8>(g + 0.5f),
+                               static_cast<Uint8>(bl + 0.5f),
+                               static_cast<Uint8>(al + 0.5f)};
+            Uint32 src = packColor(shade);
+            if (texture) {
+                int tx = clampIndex(static_cast<int>(u * texture->width),
+                                    texture->width);
+                int ty = clampIndex(static_cast<int>(v * texture->height),
+                                    texture->height);
+                size_t texel = static_cast<size_t>(ty) * texture->width + tx;
+                src = modulatePixel(texture->pixels[texel], src);
+            }
+            row[x] = blendPixel(src, row[x]);
+        }
+    }
+}
+
+bool SoftwareRasterizer::beginLayer() {
+    if (frame.empty()) {
+        return false;
+    }
+    if (layer.size() != frame.size()) {
+        layer.assign(frame.size(), OPAQUE_ALPHA);
+    }
+    target = layer.data();
+    return true;
+}
+
+void SoftwareRasterizer::endLayer() {
+    target = frame.data();
+    layerReady = true;
+}
+
+void SoftwareRasterizer::drawLayer() {
+    if (layerReady) {
+        memcpy(frame.data(), layer.data(), frame.size() * sizeof(Uint32));
+    }
+}
+
+void SoftwareRasterizer::resetLayer() {
+    // レイヤーはメモリ上にあるので失われない。次に描き直すまで使わない
+    layerReady = false;
+}
+
+void SoftwareRasterizer::present() {
+    // フレームバッファ全体を1回で転送して表示する
+    if (!screen) {
+        return;
+    }
+    SDL_UpdateTexture(screen, nullptr, frame.data(),
+                      width * static_cast<int>(sizeof(Uint32)));
+    SDL_RenderCopy(renderer, screen, nullptr, nullptr);
+    SDL_RenderPresent(renderer);
+}
+
+bool SoftwareRasterizer::readPixels(Uint32* pixels, int width,
+                                    int height) {
+    if (width > this->width || height > this->height) {
+        return false;
+    }
+    for (int y = 0; y < height; y++) {
+        memcpy(pixels + static_cast<size_t>(y) * width,
+               &frame[static_cast<size_t>(y) * this->width],
+               width * sizeof(Uint32));
+    }
+    return true;
+}
+
+bool SoftwareRasterizer::writePpm(const char* path) const {
+    if (frame.empty()) {
+        return false;
+    }
+    return ::writePpm(path, frame.data(), width, height);
+}
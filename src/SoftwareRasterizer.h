@@ -0,0 +1,70 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+#include <vector>
+
+#include "RenderBackend.h"
+
+// CPU のフレームバッファ（32ビット ARGB、1行 = width ピクセル）へ直接描く
+// 描画バックエンド
+//
+// 描画キューから来る三角形のうち、軸に平行な四角形（壁・ゲージ・指示枠・
+// 文字・円スプライト）は行ごとの塗りつぶしとアルファブレンドで描き、
+// それ以外は三角形として行ごとの範囲を求めて描く。行の処理は SSE2 で
+// 4ピクセルずつ行う（使えない環境ではスカラー）
+// 表示はフレームごとにストリーミングテクスチャへ1回転送するだけなので、
+// ドライバの描画コマンドの数に左右されない
+class SoftwareRasterizer : public RenderBackend {
+   public:
+    SoftwareRasterizer();
+    ~SoftwareRasterizer();
+
+    // width x height のフレームバッファを確保し、表示用のテクスチャを作る
+    // テクスチャの識別のために renderer が必要（画面を持たない環境では
+    // ダミーのビデオドライバのソフトウェアレンダラーを渡す）
+    bool initialize(SDL_Renderer* renderer, int width, int height);
+    // テクスチャを解放する（レンダラーより先に呼ぶ）
+    void destroy();
+
+    SDL_Texture* createTexture(SDL_Surface* surface);
+    void destroyTexture(SDL_Texture* texture);
+    void clear(SDL_Color color);
+    void drawGeometry(SDL_Texture* texture, const SDL_Vertex* vertices,
+                      int vertexCount, const int* indices, int indexCount);
+    bool beginLayer();
+    void endLayer();
+    void drawLayer();
+    void resetLayer();
+    void present();
+    bool readPixels(Uint32* pixels, int width, int height);
+
+    // 最後に描いたフレームを PPM（P6）で書き出す
+    bool writePpm(const char* path) const;
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    const Uint32* getPixels() const { return frame.data(); }
+
+   private:
+    // テクスチャの画素の CPU 側のコピー（ARGB、アルファは乗算前）
+    struct Texture {
+        SDL_Texture* handle;
+        int width, height;
+        std::vector<Uint32> pixels;
+    };
+
+    const Texture* findTexture(SDL_Texture* handle) const;
+    bool drawQuad(const Texture* texture, const SDL_Vertex* vertices,
+                  const int* quad);
+    void drawTriangle(const Texture* texture, const SDL_Vertex& a,
+                      const SDL_Vertex& b, const SDL_Vertex& c);
+
+    SDL_Renderer* renderer;
+    SDL_Texture* screen;  // 表示用のストリーミングテクスチャ
+    int width, height;
+    std::vector<Uint32> frame;
+    std::vector<Uint32> layer;
+    bool layerReady;
+    Uint32* target;  // 描画先（frame か layer）
+    std::vector<Texture> textures;
+};
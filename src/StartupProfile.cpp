@@ -0,0 +1,55 @@
+#include "StartupProfile.h"
+
+StartupProfile::StartupProfile()
+    : origin(0), lastMs(0), phaseCount(0), reported(false) {}
+
+void StartupProfile::begin() {
+    origin = SDL_GetPerformanceCounter();
+    lastMs = 0;
+    phaseCount = 0;
+    reported = false;
+}
+
+float StartupProfile::elapsedMs() const {
+    return static_cast<float>((SDL_GetPerformanceCounter() - origin) *
+                              1000.0 / SDL_GetPerformanceFrequency());
+}
+
+void StartupProfile::add(const char* name, float atMs, float durationMs) {
+    if (phaseCount >= STARTUP_MAX_PHASES) {
+        return;
+    }
+    Phase& phase = phases[phaseCount++];
+    phase.name = name;
+    phase.atMs = atMs;
+    phase.durationMs = durationMs;
+}
+
+void StartupProfile::mark(const char* name) {
+    float now = elapsedMs();
+    add(name, now, now - lastMs);
+    lastMs = now;
+}
+
+void StartupProfile::addBackground(const char* name, float durationMs) {
+    add(name, -1.0f, durationMs);
+}
+
+void StartupProfile::report() {
+    if (reported) {
+        return;
+    }
+    reported = true;
+
+    SDL_Log("Startup profile:");
+    for (int i = 0; i < phaseCount; i++) {
+        const Phase& phase = phases[i];
+        if (phase.atMs < 0) {
+            SDL_Log("  %-16s %8s  %7.2f ms (loader thread)", phase.name, "",
+                    phase.durationMs);
+        } else {
+            SDL_Log("  %-16s %8.2f  %7.2f ms", phase.name, phase.atMs,
+                    phase.durationMs);
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+// 起動処理の各段階の時刻を記録し、まとめてログに出す
+// 時刻は begin() からの経過時間（ミリ秒）
+const int STARTUP_MAX_PHASES = 16;
+
+class StartupProfile {
+   public:
+    StartupProfile();
+
+    // 計測の起点
+    void begin();
+
+    // メインスレッドで段階 name が終わった
+    void mark(const char* name);
+
+    // 別スレッドで測った処理時間（完了の通知を受けたメインスレッドで呼ぶ）
+    void addBackground(const char* name, float durationMs);
+
+    // 経過時間（ミリ秒）
+    float elapsedMs() const;
+
+    // 記録した段階を表としてログに出す（1回だけ）
+    void report();
+    bool isReported() const { return reported; }
+
+   private:
+    struct Phase {
+        const char* name;
+        float atMs;        // begin からの時刻（バックグラウンドは -1）
+        float durationMs;  // 直前の段階からの時間
+    };
+
+    void add(const char* name, float atMs, float durationMs);
+
+    Uint64 origin;
+    float lastMs;
+    Phase phases[STARTUP_MAX_PHASES];
+    int phaseCount;
+    bool reported;
+};
@@ -0,0 +1,195 @@
+#include "TextRenderer.h"
+
+#include "Constants.h"
+
+// アトラステクスチャの幅（高さはグリフ数から決まる）
+static const int ATLAS_WIDTH = 512;
+// グリフ同士のにじみ防止用の余白
+static const int ATLAS_PADDING = 1;
+
+GlyphAtlas::GlyphAtlas() : surface(nullptr), lineHeight(0) {
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        glyphs[i].src = {0, 0, 0, 0};
+        glyphs[i].advance = 0;
+    }
+}
+
+bool bakeGlyphAtlas(TTF_Font* font, GlyphAtlas& atlas) {
+    if (!font) {
+        return false;
+    }
+    int lineHeight = TTF_FontHeight(font);
+    atlas.lineHeight = lineHeight;
+
+    // 各グリフを白で描画しておき、色は頂点カラーで乗算する
+    SDL_Surface* glyphSurfaces[GLYPH_COUNT];
+    int penX = ATLAS_PADDING;
+    int penY = ATLAS_PADDING;
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        Uint16 ch = static_cast<Uint16>(GLYPH_FIRST + i);
+        glyphSurfaces[i] = TTF_RenderGlyph_Blended(font, ch, WHITE);
+
+        int minX, maxX, minY, maxY, advance;
+        if (TTF_GlyphMetrics(font, ch, &minX, &maxX, &minY, &maxY,
+                             &advance) != 0) {
+            advance = glyphSurfaces[i] ? glyphSurfaces[i]->w : 0;
+        }
+        atlas.glyphs[i].advance = advance;
+
+        if (!glyphSurfaces[i]) {
+            continue;
+        }
+
+        // 行に収まらなければ次の行へ（シェルフ詰め）
+        int w = glyphSurfaces[i]->w;
+        int h = glyphSurfaces[i]->h;
+        if (penX + w + ATLAS_PADDING > ATLAS_WIDTH) {
+            penX = ATLAS_PADDING;
+            penY += lineHeight + ATLAS_PADDING;
+        }
+        atlas.glyphs[i].src = {penX, penY, w, h};
+        penX += w + ATLAS_PADDING;
+    }
+    int atlasHeight = penY + lineHeight + ATLAS_PADDING;
+
+    SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(
+        0, ATLAS_WIDTH, atlasHeight, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!atlasSurface) {
+        SDL_Log("SDL_CreateRGBSurfaceWithFormat Error: %s", SDL_GetError());
+    } else {
+        SDL_FillRect(atlasSurface, nullptr,
+                     SDL_MapRGBA(atlasSurface->format, 255, 255, 255, 0));
+    }
+
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        if (!glyphSurfaces[i]) {
+            continue;
+        }
+        if (atlasSurface) {
+            // アルファ値をそのままコピーするためブレンドを切る
+            SDL_SetSurfaceBlendMode(glyphSurfaces[i], SDL_BLENDMODE_NONE);
+            SDL_Rect dst = atlas.glyphs[i].src;
+            SDL_BlitSurface(glyphSurfaces[i], nullptr, atlasSurface, &dst);
+        }
+        SDL_FreeSurface(glyphSurfaces[i]);
+    }
+
+    atlas.surface = atlasSurface;
+    return atlasSurface != nullptr;
+}
+
+TextRenderer::TextRenderer()
+    : backend(nullptr), atlas(nullptr), atlasHeight(0), lineHeight(0) {
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        glyphs[i].src = {0, 0, 0, 0};
+        glyphs[i].advance = 0;
+    }
+}
+
+TextRenderer::~TextRenderer() { destroy(); }
+
+bool TextRenderer::initialize(RenderBackend* backend, TTF_Font* font) {
+    GlyphAtlas baked;
+    if (!bakeGlyphAtlas(font, baked)) {
+        return false;
+    }
+    return initialize(backend, baked);
+}
+
+bool TextRenderer::initialize(RenderBackend* backend, GlyphAtlas& baked) {
+    destroy();
+    if (!backend || !baked.surface) {
+        return false;
+    }
+    this->backend = backend;
+    lineHeight = baked.lineHeight;
+    atlasHeight = baked.surface->h;
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        glyphs[i] = baked.glyphs[i];
+    }
+
+    atlas = backend->createTexture(baked.surface);
+    SDL_FreeSurface(baked.surface);
+    baked.surface = nullptr;
+    return atlas != nullptr;
+}
+
+void TextRenderer::destroy() {
+    if (atlas) {
+        backend->destroyTexture(atlas);
+        atlas = nullptr;
+    }
+    backend = nullptr;
+}
+
+const GlyphMetrics* TextRenderer::findGlyph(char c) const {
+    int index = static_cast<unsigned char>(c) - GLYPH_FIRST;
+    if (index < 0 || index >= GLYPH_COUNT) {
+        // 範囲外の文字は '?' で代用
+        index = '?' - GLYPH_FIRST;
+    }
+    return &glyphs[index];
+}
+
+void TextRenderer::measure(const char* text, int& textW, int& textH) const {
+    textW = 0;
+    textH = lineHeight;
+    for (const char* p = text; *p; p++) {
+        textW += findGlyph(*p)->advance;
+    }
+}
+
+void TextRenderer::drawText(RenderQueue& queue, const char* text,
+                            SDL_Color color, int x, int y, int layer) {
+    if (!atlas) {
+        return;
+    }
+
+    // 空白など見た目の無い文字を除いた四角形の数
+    int quadCount = 0;
+    for (const char* p = text; *p; p++) {
+        const GlyphMetrics* g = findGlyph(*p);
+        if (g->src.w > 0 && g->src.h > 0) {
+            quadCount++;
+        }
+    }
+    if (quadCount == 0) {
+        return;
+    }
+
+    float invW = 1.0f / ATLAS_WIDTH;
+    float invH = 1.0f / atlasHeight;
+
+    // 文字列全体を1つのまとまりとしてキューに積む
+    SDL_Vertex* v = queue.addQuads(atlas, quadCount, layer);
+    int penX = x;
+    for (const char* p = text; *p; p++) {
+        const GlyphMetrics* g = findGlyph(*p);
+        if (g->src.w > 0 && g->src.h > 0) {
+            float x0 = static_cast<float>(penX);
+            float y0 = static_cast<float>(y);
+            float x1 = x0 + g->src.w;
+            float y1 = y0 + g->src.h;
+            float u0 = g->src.x * invW;
+            float v0 = g->src.y * invH;
+            float u1 = (g->src.x + g->src.w) * invW;
+            float v1 = (g->src.y + g->src.h) * invH;
+
+            v[0] = {{x0, y0}, color, {u0, v0}};
+            v[1] = {{x1, y0}, color, {u1, v0}};
+            v[2] = {{x1, y1}, color, {u1, v1}};
+            v[3] = {{x0, y1}, color, {u0, v1}};
+            v += 4;
+        }
+        penX += g->advance;
+    }
+}
+
+void TextRenderer::drawTextCentered(RenderQueue& queue, const char* text,
+                                    SDL_Color color, int centerX,
+                                    int centerY, int layer) {
+    int textW, textH;
+    measure(text, textW, textH);
+    drawText(queue, text, color, centerX - textW / 2, centerY - textH / 2,
+             layer);
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include "RenderBackend.h"
+#include "RenderQueue.h"
+
+// グリフアトラスに焼き込む文字範囲（ASCII印字可能文字）
+const int GLYPH_FIRST = 32;
+const int GLYPH_LAST = 126;
+const int GLYPH_COUNT = GLYPH_LAST - GLYPH_FIRST + 1;
+
+// アトラス上の1文字分
+struct GlyphMetrics {
+    SDL_Rect src;  // アトラス上の位置
+    int advance;   // 次の文字までの送り幅
+};
+
+// フォントの全グリフを焼き込んだアトラスの画像（CPU側）と文字ごとの情報
+// レンダラーを使わないので、読み込みスレッドで作ってから渡せる
+struct GlyphAtlas {
+    GlyphAtlas();
+
+    SDL_Surface* surface;
+    int lineHeight;
+    GlyphMetrics glyphs[GLYPH_COUNT];
+};
+
+// font の全グリフを atlas に焼き込む（surface は呼び出し側が解放する）
+bool bakeGlyphAtlas(TTF_Font* font, GlyphAtlas& atlas);
+
+// フォントの全グリフを1枚のテクスチャに焼き込み、
+// 文字列をアトラスからの矩形として描画キューに積む
+// （同じフレームの文字はすべて同じテクスチャなので1回の描画にまとまる）
+class TextRenderer {
+   public:
+    TextRenderer();
+    ~TextRenderer();
+
+    // アトラスを生成する（initialize時に1回だけ呼ぶ）
+    bool initialize(RenderBackend* backend, TTF_Font* font);
+    // 焼き込み済みのアトラスをテクスチャにする（atlas.surface は解放される）
+    bool initialize(RenderBackend* backend, GlyphAtlas& atlas);
+    void destroy();
+
+    // 文字列の描画サイズを計算する
+    void measure(const char* text, int& textW, int& textH) const;
+
+    // 文字列を (x, y) を左上として描画する
+    void drawText(RenderQueue& queue, const char* text, SDL_Color color,
+                  int x, int y, int layer = LAYER_TEXT);
+
+    // 文字列を (centerX, centerY) を中心として描画する
+    void drawTextCentered(RenderQueue& queue, const char* text,
+                          SDL_Color color, int centerX, int centerY,
+                          int layer = LAYER_TEXT);
+
+    bool isReady() const { return atlas != nullptr; }
+    int getLineHeight() const { return lineHeight; }
+
+   private:
+    const GlyphMetrics* findGlyph(char c) const;
+
+    RenderBackend* backend;
+    SDL_Texture* atlas;
+    int atlasHeight;
+    int lineHeight;
+    GlyphMetrics glyphs[GLYPH_COUNT];
+};
@@ -0,0 +1,45 @@
+#pragma once
+#include <atomic>
+
+// 1つの書き手から1つの読み手へ最新の値を渡すロックなしのトリプルバッファ
+//
+// 書き手と読み手はそれぞれ専用の領域を持ち、3つ目の領域（shared）と
+// 入れ替えることで受け渡す。書き手は読み手を待たずに何度でも公開でき、
+// 読み手は常に最後に公開された値を読む（途中の値は読み飛ばされる）
+template <typename T>
+class TripleBuffer {
+   public:
+    TripleBuffer() : back(0), front(1), shared(2) {}
+
+    // 書き手側：次に書く領域（前回の内容は残っていないものとして全部書く）
+    T& writeSlot() { return slots[back]; }
+
+    // 書き手側：書き終えた領域を公開し、空いた領域を次の書き込み先にする
+    void publish() {
+        back = shared.exchange(back | FRESH, std::memory_order_acq_rel) &
+               INDEX_MASK;
+    }
+
+    // 読み手側：新しく公開された値があれば読む領域と入れ替える
+    // 戻り値は入れ替えたか
+    bool acquire() {
+        if (!(shared.load(std::memory_order_relaxed) & FRESH)) {
+            return false;
+        }
+        front = shared.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    // 読み手側：最後に acquire した値
+    const T& readSlot() const { return slots[front]; }
+
+   private:
+    // shared の下位2ビットが領域の番号、FRESH は未読の公開があること
+    static const int INDEX_MASK = 3;
+    static const int FRESH = 4;
+
+    T slots[3];
+    int back;   // 書き手専用
+    int front;  // 読み手専用
+    std::atomic<int> shared;
+};
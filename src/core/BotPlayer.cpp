@@ -0,0 +1,85 @@
+#include "BotPlayer.h"
+
+#include <cmath>
+
+Direction findCorrectDirection(const SimState& state) {
+    return correctDirection(state.round);
+}
+
+BotPlayer::BotPlayer(const BotConfig& config, uint64_t seed)
+    : config(config), rng(seed) {
+    reset();
+}
+
+void BotPlayer::reset() {
+    planned = false;
+    acted = false;
+    plannedScore = -1;
+    roundStart = 0;
+    plannedReaction = 0;
+    plannedDirection = DIR_NONE;
+}
+
+uint32_t BotPlayer::sampleReaction() {
+    if (config.reactionSigma <= 0.0) {
+        return static_cast<uint32_t>(config.reactionMedianMs);
+    }
+
+    // Box-Muller 法で標準正規乱数を作り、対数正規分布に変換する
+    double u1 = 1.0 - rng.nextDouble();  // (0, 1]
+    double u2 = rng.nextDouble();
+    double z = std::sqrt(-2.0 * std::log(u1)) *
+               std::cos(6.283185307179586 * u2);
+    double reaction =
+        config.reactionMedianMs * std::exp(config.reactionSigma * z);
+    return static_cast<uint32_t>(reaction);
+}
+
+void BotPlayer::planRound(const SimState& state) {
+    planned = true;
+    acted = false;
+    plannedScore = state.score;
+    roundStart = state.now;
+    plannedReaction = sampleReaction();
+
+    Direction correct = findCorrectDirection(state);
+    plannedDirection = correct;
+    if (rng.nextDouble() < config.errorRate) {
+        // 指示色でない壁の方向から1つ選ぶ（壁の色は独立なので、正解の
+        // 壁が複数あることもある。すべて正解なら誤りようがない）
+        int wrongSides =
+            ~ROUND_CORRECT_SIDES[state.round & (ROUND_TABLE_SIZE - 1)] &
+            ((1 << WALL_COUNT) - 1);
+        int wrongCount = 0;
+        for (int side = 0; side < WALL_COUNT; side++) {
+            wrongCount += (wrongSides >> side) & 1;
+        }
+        if (wrongCount > 0) {
+            int pick = rng.nextInt(wrongCount);
+            for (int side = 0; side < WALL_COUNT; side++) {
+                if (((wrongSides >> side) & 1) && pick-- == 0) {
+                    plannedDirection = static_cast<Direction>(DIR_UP + side);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+SimInput BotPlayer::think(const SimState& state) {
+    SimInput input;
+    if (state.gameState != STATE_PLAYING) {
+        return input;
+    }
+
+    // 成功してスコアが変わったら次のラウンド
+    if (!planned || state.score != plannedScore) {
+        planRound(state);
+    }
+
+    if (!acted && state.now - roundStart >= plannedReaction) {
+        input.dir = plannedDirection;
+        acted = true;
+    }
+    return input;
+}
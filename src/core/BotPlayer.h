@@ -0,0 +1,52 @@
+#pragma once
+#include <stdint.h>
+
+#include "Random.h"
+#include "Simulation.h"
+
+// 自動プレイヤーのモデル
+struct BotConfig {
+    double reactionMedianMs;  // 反応時間の中央値（ミリ秒）
+    double reactionSigma;     // 反応時間の対数正規分布のσ（0なら固定）
+    double errorRate;         // 誤った方向へ動く確率
+
+    BotConfig()
+        : reactionMedianMs(350.0), reactionSigma(0.25), errorRate(0.02) {}
+};
+
+// 指示色の壁の方向を返す（複数あれば上・下・左・右の順で最初のもの）
+Direction findCorrectDirection(const SimState& state);
+
+// 壁の色と指示色を見て方向を選ぶ自動プレイヤー（SDLに依存しない）
+//
+// ラウンドごとに反応時間を対数正規分布から引き、その時間が経過した
+// ティックで選んだ方向を入力する。乱数はシミュレーションとは別系列
+class BotPlayer {
+   public:
+    BotPlayer(const BotConfig& config, uint64_t seed);
+
+    // 新しいセッションの前に呼ぶ
+    void reset();
+
+    // 現在のラウンドの反応時間と方向を決める
+    void planRound(const SimState& state);
+    uint32_t getPlannedReaction() const { return plannedReaction; }
+    Direction getPlannedDirection() const { return plannedDirection; }
+
+    // 毎ティック呼び出し、このティックで適用する入力を返す
+    SimInput think(const SimState& state);
+
+   private:
+    uint32_t sampleReaction();
+
+    BotConfig config;
+    Random rng;
+
+    // 計画中のラウンド
+    bool planned;
+    bool acted;
+    int plannedScore;  // 計画したラウンドのスコア（変われば次のラウンド）
+    uint32_t roundStart;
+    uint32_t plannedReaction;
+    Direction plannedDirection;
+};
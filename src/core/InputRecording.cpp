@@ -0,0 +1,191 @@
+#include "InputRecording.h"
+
+#include <cstdio>
+#include <cstring>
+
+static const char RECORDING_MAGIC[4] = {'C', 'W', 'R', 'P'};
+static const uint16_t RECORDING_VERSION = 2;
+
+// 入力コードのビット配置
+static const int INPUT_CODE_BITS = 4;
+static const uint32_t INPUT_CODE_QUIT = 1 << 3;
+static const uint32_t INPUT_CODE_DIR_MASK = 7;
+
+// 整数をリトルエンディアンで読み書きする
+static void writeLE(FILE* file, uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        fputc(static_cast<int>((value >> (i * 8)) & 0xFF), file);
+    }
+}
+
+static bool readLE(FILE* file, uint32_t& value, int bytes) {
+    value = 0;
+    for (int i = 0; i < bytes; i++) {
+        int c = fgetc(file);
+        if (c == EOF) {
+            return false;
+        }
+        value |= static_cast<uint32_t>(c) << (i * 8);
+    }
+    return true;
+}
+
+// 可変長整数（LEB128）
+static void writeVarint(FILE* file, uint64_t value) {
+    do {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        if (value) {
+            byte |= 0x80;
+        }
+        fputc(byte, file);
+    } while (value);
+}
+
+static bool readVarint(FILE* file, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int c = fgetc(file);
+        if (c == EOF) {
+            return false;
+        }
+        value |= static_cast<uint64_t>(c & 0x7F) << shift;
+        if (!(c & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+InputRecording::InputRecording()
+    : seed(0), tickMs(0), finalTick(0), finalScore(0), cursor(0) {}
+
+void InputRecording::reset(uint32_t seed, uint32_t tickMs) {
+    this->seed = seed;
+    this->tickMs = tickMs;
+    finalTick = 0;
+    finalScore = 0;
+    inputs.clear();
+    inputs.reserve(RECORDING_RESERVE_INPUTS);
+    cursor = 0;
+}
+
+void InputRecording::addInput(uint32_t tick, const SimInput& input) {
+    if (input.dir == DIR_NONE && !input.quit) {
+        return;
+    }
+    RecordedInput recorded;
+    recorded.tick = tick;
+    recorded.input = input;
+    inputs.push_back(recorded);
+}
+
+void InputRecording::setResult(uint32_t finalTick, int finalScore) {
+    this->finalTick = finalTick;
+    this->finalScore = finalScore;
+}
+
+bool InputRecording::save(const char* path) const {
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+
+    fwrite(RECORDING_MAGIC, 1, sizeof(RECORDING_MAGIC), file);
+    writeLE(file, RECORDING_VERSION, 2);
+    writeLE(file, tickMs, 2);
+    writeLE(file, seed, 4);
+    writeLE(file, finalTick, 4);
+    writeLE(file, static_cast<uint32_t>(finalScore), 4);
+    writeLE(file, static_cast<uint32_t>(inputs.size()), 4);
+
+    uint32_t lastTick = 0;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        const RecordedInput& recorded = inputs[i];
+        uint64_t delta = recorded.tick - lastTick;
+        uint32_t code = static_cast<uint32_t>(recorded.input.dir);
+        if (recorded.input.quit) {
+            code |= INPUT_CODE_QUIT;
+        }
+        writeVarint(file, (delta << INPUT_CODE_BITS) | code);
+        if (recorded.input.dir != DIR_NONE) {
+            writeVarint(file, recorded.input.offsetMs);
+        }
+        lastTick = recorded.tick;
+    }
+
+    bool ok = ferror(file) == 0;
+    fclose(file);
+    return ok;
+}
+
+bool InputRecording::load(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version, fileTickMs, fileSeed, fileFinalTick, fileFinalScore,
+        count;
+    bool ok = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+              memcmp(magic, RECORDING_MAGIC, sizeof(magic)) == 0 &&
+              readLE(file, version, 2) && version >= 1 &&
+              version <= RECORDING_VERSION &&
+              readLE(file, fileTickMs, 2) && readLE(file, fileSeed, 4) &&
+              readLE(file, fileFinalTick, 4) &&
+              readLE(file, fileFinalScore, 4) && readLE(file, count, 4);
+    if (!ok || fileTickMs == 0) {
+        fclose(file);
+        return false;
+    }
+
+    reset(fileSeed, fileTickMs);
+    finalTick = fileFinalTick;
+    finalScore = static_cast<int>(fileFinalScore);
+
+    uint32_t tick = 0;
+    while (inputs.size() < count) {
+        uint64_t value;
+        if (!readVarint(file, value)) {
+            ok = false;
+            break;
+        }
+        tick += static_cast<uint32_t>(value >> INPUT_CODE_BITS);
+        uint32_t dir = static_cast<uint32_t>(value & INPUT_CODE_DIR_MASK);
+        if (dir > DIR_RIGHT) {
+            ok = false;
+            break;
+        }
+
+        RecordedInput recorded;
+        recorded.tick = tick;
+        recorded.input.dir = static_cast<Direction>(dir);
+        recorded.input.quit = (value & INPUT_CODE_QUIT) != 0;
+        if (version >= 2 && recorded.input.dir != DIR_NONE) {
+            uint64_t offset;
+            if (!readVarint(file, offset) || offset >= fileTickMs) {
+                ok = false;
+                break;
+            }
+            recorded.input.offsetMs = static_cast<uint32_t>(offset);
+        }
+        inputs.push_back(recorded);
+    }
+
+    fclose(file);
+    return ok;
+}
+
+bool InputRecording::nextInput(uint32_t tick, SimInput& input) {
+    // 過ぎたティックの入力は読み飛ばす
+    while (cursor < inputs.size() && inputs[cursor].tick < tick) {
+        cursor++;
+    }
+    if (cursor < inputs.size() && inputs[cursor].tick == tick) {
+        input = inputs[cursor].input;
+        cursor++;
+        return true;
+    }
+    return false;
+}
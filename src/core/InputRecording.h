@@ -0,0 +1,64 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "Simulation.h"
+
+// 記録された1件の入力
+struct RecordedInput {
+    uint32_t tick;  // 入力を適用したティック番号
+    SimInput input;
+};
+
+// 記録用に最初に確保しておく入力の件数（通常のセッションはこの範囲に収まる）
+const size_t RECORDING_RESERVE_INPUTS = 4096;
+
+// 入力の記録と再生（SDLに依存しない）
+//
+// 乱数シードと固定ティック長、ティックごとの入力を保存しておけば
+// stepSimulation を同じ順に呼ぶことでセッションを完全に再現できる
+//
+// ファイル形式（リトルエンディアン）
+//   magic "CWRP" / version u16 / tickMs u16 / seed u32
+//   finalTick u32 / finalScore u32 / eventCount u32
+//   以降 eventCount 件の可変長整数（LEB128）:
+//     (前の入力からのティック差 << 4) | (終了要求 << 3) | Direction
+//     移動方向がある場合は続けてティック内の時刻 offsetMs
+//     （version 1 のファイルには無く、0 として読む）
+class InputRecording {
+   public:
+    InputRecording();
+
+    // 記録を開始する
+    void reset(uint32_t seed, uint32_t tickMs);
+
+    // tick で適用した入力を追加する（空の入力は無視）
+    void addInput(uint32_t tick, const SimInput& input);
+
+    // セッション終了時の結果を記録する（再生時の一致確認用）
+    void setResult(uint32_t finalTick, int finalScore);
+
+    bool save(const char* path) const;
+    bool load(const char* path);
+
+    // 再生：tick に適用する入力があれば input に設定して true を返す
+    // ティックの昇順で呼び出すこと
+    bool nextInput(uint32_t tick, SimInput& input);
+    void rewind() { cursor = 0; }
+
+    uint32_t getSeed() const { return seed; }
+    uint32_t getTickMs() const { return tickMs; }
+    uint32_t getFinalTick() const { return finalTick; }
+    int getFinalScore() const { return finalScore; }
+    size_t getInputCount() const { return inputs.size(); }
+
+   private:
+    uint32_t seed;
+    uint32_t tickMs;
+    uint32_t finalTick;
+    int finalScore;
+    std::vector<RecordedInput> inputs;
+    size_t cursor;
+};
@@ -1,9 +1,5 @@
 #include "Player.h"
 
-#include <cmath>
-
-#include "Utility.h"
-
 Player::Player() { reset(); }
 
 void Player::reset() {
@@ -27,13 +23,13 @@ void Player::setPosition(float newX, float newY) {
     targetY = y;
 }
 
-void Player::setMovementTarget(Direction dir) {
+void Player::setMovementTarget(Direction dir, uint32_t now) {
     if (dir == DIR_NONE || isMoving()) {
         return;
     }
 
     moveDir = dir;
-    moveStartTime = SDL_GetTicks();
+    moveStartTime = now;
     startX = x;
     startY = y;
 
@@ -60,13 +56,13 @@ void Player::setMovementTarget(Direction dir) {
     }
 }
 
-void Player::update(Uint32 currentTime) {
+void Player::update(uint32_t currentTime) {
     if (moveDir == DIR_NONE) {
         return;
     }
 
     // 経過時間に基づいて位置を線形補間
-    Uint32 elapsed = currentTime - moveStartTime;
+    uint32_t elapsed = currentTime - moveStartTime;
     float t = static_cast<float>(elapsed) / MOVE_DURATION;
 
     // 移動完了後は位置を固定
@@ -79,46 +75,14 @@ void Player::update(Uint32 currentTime) {
     y = startY + t * (targetY - startY);
 }
 
-void Player::render(SDL_Renderer* renderer) {
-    // プレイヤーを白い円として描画
-    SDL_SetRenderDrawColor(renderer, WHITE.r, WHITE.g, WHITE.b, WHITE.a);
-
-    // 円の描画（簡易的な実装）
-    for (int w = 0; w < PLAYER_RADIUS * 2; w++) {
-        for (int h = 0; h < PLAYER_RADIUS * 2; h++) {
-            int dx = PLAYER_RADIUS - w;
-            int dy = PLAYER_RADIUS - h;
-            if ((dx * dx + dy * dy) <= (PLAYER_RADIUS * PLAYER_RADIUS)) {
-                SDL_RenderDrawPoint(renderer,
-                                    static_cast<int>(x) + dx - PLAYER_RADIUS,
-                                    static_cast<int>(y) + dy - PLAYER_RADIUS);
-            }
-        }
-    }
-}
-
-bool Player::checkCollision(Direction dir, SDL_Color wallTopColor,
-                            SDL_Color wallBottomColor, SDL_Color wallLeftColor,
-                            SDL_Color wallRightColor,
-                            SDL_Color directiveColor) {
-    // 移動方向と壁の色が一致するかをチェック
-    switch (dir) {
-        case DIR_UP:
-            return isSameColor(wallTopColor, directiveColor);
-        case DIR_DOWN:
-            return isSameColor(wallBottomColor, directiveColor);
-        case DIR_LEFT:
-            return isSameColor(wallLeftColor, directiveColor);
-        case DIR_RIGHT:
-            return isSameColor(wallRightColor, directiveColor);
-        default:
-            return false;
-    }
+bool Player::checkCollision(Direction dir, RoundDescriptor round) const {
+    // 移動方向の壁が指示色かを判定テーブルで調べる
+    return isCorrectDirection(round, dir);
 }
 
 bool Player::isMoving() const { return moveDir != DIR_NONE; }
 
-bool Player::isMovementComplete(Uint32 currentTime) const {
+bool Player::isMovementComplete(uint32_t currentTime) const {
     if (moveDir == DIR_NONE) {
         return false;
     }
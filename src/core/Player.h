@@ -1,26 +1,26 @@
 #pragma once
-#include <SDL2/SDL.h>
+#include <stdint.h>
 
-#include "Constants.h"
+#include "RoundColors.h"
+#include "Rules.h"
 
+// プレイヤーの位置と移動アニメーション（SDLに依存しない）
+// 描画は PlayerRenderer 側で行う
 class Player {
    public:
     Player();
     void reset();
-    void setMovementTarget(Direction dir);
-    void update(Uint32 currentTime);
-    void render(SDL_Renderer* renderer);
-    bool checkCollision(Direction dir, SDL_Color wallTopColor,
-                        SDL_Color wallBottomColor, SDL_Color wallLeftColor,
-                        SDL_Color wallRightColor, SDL_Color directiveColor);
+    void setMovementTarget(Direction dir, uint32_t now);
+    void update(uint32_t currentTime);
+    bool checkCollision(Direction dir, RoundDescriptor round) const;
     bool isMoving() const;
-    bool isMovementComplete(Uint32 currentTime) const;
+    bool isMovementComplete(uint32_t currentTime) const;
 
     // アクセサ
     float getX() const { return x; }
     float getY() const { return y; }
     Direction getMoveDir() const { return moveDir; }
-    Uint32 getMoveStartTime() const { return moveStartTime; }
+    uint32_t getMoveStartTime() const { return moveStartTime; }
     float getTargetX() const { return targetX; }
     float getTargetY() const { return targetY; }
 
@@ -32,5 +32,5 @@ class Player {
     float startX, startY;    // 移動開始位置
     float targetX, targetY;  // 移動目標位置
     Direction moveDir;       // 現在の移動方向
-    Uint32 moveStartTime;    // 移動開始時刻
+    uint32_t moveStartTime;  // 移動開始時刻
 };
\ No newline at end of file
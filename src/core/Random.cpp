@@ -0,0 +1,43 @@
+#include "Random.h"
+
+void Random::seed(uint64_t seedValue) {
+    // splitmix64 で全状態ビットに散らす（全ゼロ状態を避ける）
+    uint64_t x = seedValue;
+    for (int i = 0; i < 4; i++) {
+        x += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = x;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        s[i] = z ^ (z >> 31);
+    }
+}
+
+void Random::jump() {
+    static const uint64_t JUMP[] = {0x180EC6D33CFD0ABAULL,
+                                    0xD5A61266F0C9392CULL,
+                                    0xA9582618E03FC9AAULL,
+                                    0x39ABDC4529B1661CULL};
+
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (JUMP[i] & (1ULL << b)) {
+                s0 ^= s[0];
+                s1 ^= s[1];
+                s2 ^= s[2];
+                s3 ^= s[3];
+            }
+            next();
+        }
+    }
+    s[0] = s0;
+    s[1] = s1;
+    s[2] = s2;
+    s[3] = s3;
+}
+
+Random Random::split() {
+    Random child = *this;
+    jump();
+    return child;
+}
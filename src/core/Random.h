@@ -0,0 +1,52 @@
+#pragma once
+#include <stdint.h>
+
+// インスタンスごとに持つ高速な擬似乱数生成器（xoshiro256**）
+//
+// グローバルな rand() と違い状態を共有しないため、複数のゲームを
+// 別スレッドで同時に回しても互いに影響しない
+// split() で重ならない独立した系列を派生できる
+class Random {
+   public:
+    Random() { seed(0); }
+    explicit Random(uint64_t seedValue) { seed(seedValue); }
+
+    // シードから内部状態を初期化する（splitmix64 で展開）
+    void seed(uint64_t seedValue);
+
+    // 64ビットの乱数を返す
+    uint64_t next() {
+        const uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // [0, bound) の一様な整数を返す（bound > 0）
+    uint32_t nextInt(uint32_t bound) {
+        // 上位32ビットに bound を掛けて範囲に写す（Lemire の方法）
+        return static_cast<uint32_t>(((next() >> 32) * bound) >> 32);
+    }
+
+    // [0, 1) の一様な実数を返す
+    double nextDouble() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+
+    // 2^128 回分先へ進める（系列を重ならない区間に分ける）
+    void jump();
+
+    // 現在の系列から独立した系列を派生させる
+    // 戻り値は現在位置の系列、自身は jump() 後の位置へ進む
+    Random split();
+
+   private:
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t s[4];
+};
@@ -0,0 +1,29 @@
+#include "RoundColors.h"
+
+uint8_t ROUND_CORRECT_SIDES[ROUND_TABLE_SIZE];
+uint8_t ROUND_CORRECT_DIRECTION[ROUND_TABLE_SIZE];
+
+namespace {
+
+// 全記述子について正解の壁を前計算する（静的初期化時に1回）
+struct RoundTableBuilder {
+    RoundTableBuilder() {
+        for (int round = 0; round < ROUND_TABLE_SIZE; round++) {
+            RoundDescriptor r = static_cast<RoundDescriptor>(round);
+            uint8_t sides = 0;
+            uint8_t first = DIR_NONE;
+            for (int side = WALL_COUNT - 1; side >= 0; side--) {
+                if (roundWall(r, side) == roundDirective(r)) {
+                    sides |= 1 << side;
+                    first = static_cast<uint8_t>(DIR_UP + side);
+                }
+            }
+            ROUND_CORRECT_SIDES[round] = sides;
+            ROUND_CORRECT_DIRECTION[round] = first;
+        }
+    }
+};
+
+const RoundTableBuilder roundTableBuilder;
+
+}  // namespace
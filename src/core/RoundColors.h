@@ -0,0 +1,78 @@
+#pragma once
+#include <stdint.h>
+
+#include "Rules.h"
+
+// 色とラウンドのコンパクトな表現（SDLに依存しない）
+//
+// 色は colorSet のインデックス（2ビット）で扱い、SDL_Color に変換するのは
+// 描画時だけにする。1ラウンドの4枚の壁と指示色は16ビットに詰める
+//
+//   bit 9-8: 指示色
+//   bit 7-6: 上の壁 / bit 5-4: 下の壁 / bit 3-2: 左の壁 / bit 1-0: 右の壁
+
+// 色のインデックス（0〜COLOR_COUNT-1）
+typedef uint8_t ColorIndex;
+
+// 4枚の壁と指示色を詰めたラウンドの記述子
+typedef uint16_t RoundDescriptor;
+
+// 壁の位置（Direction から DIR_UP を引いた値と同じ並び）
+enum WallSide { WALL_TOP, WALL_BOTTOM, WALL_LEFT, WALL_RIGHT, WALL_COUNT };
+
+// 記述子として意味のあるビット数と、判定テーブルの大きさ
+const int ROUND_BITS = 10;
+const int ROUND_TABLE_SIZE = 1 << ROUND_BITS;
+
+static_assert(COLOR_COUNT == 4, "colors are packed as 2-bit indices");
+
+// 記述子ごとの判定テーブル（RoundColors.cpp で起動時に作る）
+// 正解の壁のビットマスク（bit s = WallSide s が指示色）
+extern uint8_t ROUND_CORRECT_SIDES[ROUND_TABLE_SIZE];
+// 正解の方向（複数あれば上・下・左・右の順で最初のもの）
+extern uint8_t ROUND_CORRECT_DIRECTION[ROUND_TABLE_SIZE];
+
+inline int wallShift(int side) { return 6 - side * 2; }
+
+inline ColorIndex roundWall(RoundDescriptor round, int side) {
+    return static_cast<ColorIndex>((round >> wallShift(side)) & 3);
+}
+
+inline ColorIndex roundDirective(RoundDescriptor round) {
+    return static_cast<ColorIndex>((round >> 8) & 3);
+}
+
+inline RoundDescriptor makeRound(ColorIndex directive, ColorIndex top,
+                                 ColorIndex bottom, ColorIndex left,
+                                 ColorIndex right) {
+    return static_cast<RoundDescriptor>((directive << 8) | (top << 6) |
+                                        (bottom << 4) | (left << 2) | right);
+}
+
+// 方向 dir の壁が指示色か（マスクとの AND 1回で判定）
+inline bool isCorrectDirection(RoundDescriptor round, Direction dir) {
+    if (dir == DIR_NONE) {
+        return false;
+    }
+    return (ROUND_CORRECT_SIDES[round & (ROUND_TABLE_SIZE - 1)] >>
+            (dir - DIR_UP)) &
+           1;
+}
+
+// 正解の方向
+inline Direction correctDirection(RoundDescriptor round) {
+    return static_cast<Direction>(
+        ROUND_CORRECT_DIRECTION[round & (ROUND_TABLE_SIZE - 1)]);
+}
+
+// 64ビットの乱数からラウンドを作る
+// 指示色と4枚の壁を上位10ビットからそのまま切り出し、
+// 次の2ビットで選んだ壁を必ず指示色にする
+inline RoundDescriptor drawRound(uint64_t bits) {
+    RoundDescriptor round =
+        static_cast<RoundDescriptor>((bits >> 54) & (ROUND_TABLE_SIZE - 1));
+    int shift = wallShift(static_cast<int>((bits >> 52) & 3));
+    round = static_cast<RoundDescriptor>((round & ~(3 << shift)) |
+                                         (roundDirective(round) << shift));
+    return round;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <stdint.h>
+
+// ゲームルールに関わる定数（SDLに依存しない）
+
+// ウィンドウサイズ・壁の厚さなどの定数
+const int WINDOW_WIDTH = 800;
+const int WINDOW_HEIGHT = 600;
+const int WALL_THICKNESS = 50;
+
+// ゲームタイマー初期値（ミリ秒）
+// 固定ステップで正確に0へ到達するよう整数で扱う
+const int INITIAL_MAX_TIME = 3000;  // 3.0秒
+const int MIN_MAX_TIME = 1500;      // 1.5秒
+
+// 難易度上昇：何回成功ごとに何ミリ秒短縮するか
+const int DIFFICULTY_STEP_COUNT = 5;
+const int DIFFICULTY_STEP_TIME = 200;  // 0.2秒
+
+// プレイヤー移動のアニメーション時間（ミリ秒）
+const uint32_t MOVE_DURATION = 300;  // 0.3秒
+
+// シミュレーションの既定ティックレート（Hz）
+// 1ティックの長さ（1000 / レート）は整数ミリ秒になる値を使う
+const int DEFAULT_TICK_RATE = 200;
+
+// ゲームオーバー表示を続ける時間（ミリ秒）
+const uint32_t GAMEOVER_HOLD_TIME = 2000;
+
+// プレイヤーのサイズ（半径）
+const int PLAYER_RADIUS = 15;
+
+// 色の種類数（colorSet のインデックスで扱う）
+const int COLOR_COUNT = 4;
+
+// ゲーム状態
+enum GameState { STATE_COUNTDOWN, STATE_PLAYING, STATE_MOVING, STATE_GAMEOVER };
+
+// 移動方向
+enum Direction { DIR_NONE, DIR_UP, DIR_DOWN, DIR_LEFT, DIR_RIGHT };
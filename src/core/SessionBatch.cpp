@@ -0,0 +1,362 @@
+#include "SessionBatch.h"
+
+// AVX2 は関数ごとに target で有効にし、実行時に確認する
+// SSE2 はコンパイラが使える場合（x86-64 は常に、32ビットは -msse2）だけ
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SESSION_BATCH_X86 1
+#ifdef __SSE2__
+#define SESSION_BATCH_SSE2 1
+#endif
+#endif
+
+// プレイヤーの初期位置（画面中央）
+static const float PLAYER_START_X = WINDOW_WIDTH / 2.0f;
+static const float PLAYER_START_Y = WINDOW_HEIGHT / 2.0f;
+
+SessionBatch::SessionBatch() : count(0), kernel(KERNEL_SCALAR) {
+    setKernel(KERNEL_AVX2);
+}
+
+void SessionBatch::setKernel(Kernel requested) {
+    kernel = KERNEL_SCALAR;
+#ifdef SESSION_BATCH_X86
+    // SSE2 はビルドで使える場合だけ。AVX2 は実行時に確認する
+#ifdef SESSION_BATCH_SSE2
+    if (requested >= KERNEL_SSE2) {
+        kernel = KERNEL_SSE2;
+    }
+#endif
+    if (requested == KERNEL_AVX2 && __builtin_cpu_supports("avx2")) {
+        kernel = KERNEL_AVX2;
+    }
+#else
+    (void)requested;
+#endif
+}
+
+void SessionBatch::clear() {
+    count = 0;
+    gameState.clear();
+    now.clear();
+    gameOverTime.clear();
+    currentTime.clear();
+    currentMaxTime.clear();
+    moveStartTime.clear();
+    playerX.clear();
+    playerY.clear();
+    moveDX.clear();
+    moveDY.clear();
+    score.clear();
+    successCount.clear();
+    round.clear();
+    moveDir.clear();
+    rng.clear();
+}
+
+size_t SessionBatch::add(uint64_t seed) {
+    size_t i = count++;
+
+    // resetRound と同じ初期状態
+    gameState.push_back(STATE_PLAYING);
+    now.push_back(0);
+    gameOverTime.push_back(0);
+    currentTime.push_back(INITIAL_MAX_TIME);
+    currentMaxTime.push_back(INITIAL_MAX_TIME);
+    moveStartTime.push_back(0);
+    playerX.push_back(PLAYER_START_X);
+    playerY.push_back(PLAYER_START_Y);
+    moveDX.push_back(0.0f);
+    moveDY.push_back(0.0f);
+    score.push_back(0);
+    successCount.push_back(0);
+    moveDir.push_back(DIR_NONE);
+    rng.push_back(Random(seed));
+    round.push_back(drawRound(rng[i].next()));
+    return i;
+}
+
+void SessionBatch::applyInput(size_t i, const SimInput& input,
+                              uint32_t dtMs) {
+    // 終了要求
+    if (input.quit && gameState[i] != STATE_GAMEOVER) {
+        gameState[i] = STATE_GAMEOVER;
+        gameOverTime[i] = now[i];
+    }
+
+    // 入力はプレイ中かつ移動中でない場合のみ受け付ける
+    // 入力の時刻で既に時間切れなら受け付けない
+    int32_t offset =
+        static_cast<int32_t>(input.offsetMs < dtMs ? input.offsetMs : 0);
+    if (gameState[i] != STATE_PLAYING || input.dir == DIR_NONE ||
+        moveDir[i] != DIR_NONE || currentTime[i] <= offset) {
+        return;
+    }
+
+    // Player::setMovementTarget と同じ目標座標
+    float targetX = playerX[i];
+    float targetY = playerY[i];
+    switch (input.dir) {
+        case DIR_UP:
+            targetY = WALL_THICKNESS + PLAYER_RADIUS;
+            break;
+        case DIR_DOWN:
+            targetY = WINDOW_HEIGHT - WALL_THICKNESS - PLAYER_RADIUS;
+            break;
+        case DIR_LEFT:
+            targetX = WALL_THICKNESS + PLAYER_RADIUS;
+            break;
+        case DIR_RIGHT:
+            targetX = WINDOW_WIDTH - WALL_THICKNESS - PLAYER_RADIUS;
+            break;
+        default:
+            break;
+    }
+
+    moveDir[i] = static_cast<uint8_t>(input.dir);
+    moveStartTime[i] = now[i] + offset;
+    moveDX[i] = targetX - playerX[i];
+    moveDY[i] = targetY - playerY[i];
+    gameState[i] = STATE_MOVING;
+}
+
+void SessionBatch::resolveMovement(size_t i) {
+    // 衝突判定：移動方向の壁が指示色か
+    if (!isCorrectDirection(round[i], static_cast<Direction>(moveDir[i]))) {
+        // 失敗（ゲームオーバー）
+        gameState[i] = STATE_GAMEOVER;
+        gameOverTime[i] = now[i];
+        return;
+    }
+
+    // 成功
+    score[i]++;
+    successCount[i]++;
+    currentMaxTime[i] = nextMaxTime(currentMaxTime[i], successCount[i]);
+
+    // 次ラウンドの準備
+    playerX[i] = PLAYER_START_X;
+    playerY[i] = PLAYER_START_Y;
+    moveDir[i] = DIR_NONE;
+    currentTime[i] = currentMaxTime[i];
+    round[i] = drawRound(rng[i].next());
+    gameState[i] = STATE_PLAYING;
+}
+
+void SessionBatch::step(uint32_t dtMs) {
+    int32_t dt = static_cast<int32_t>(dtMs);
+    size_t done = 0;
+#ifdef SESSION_BATCH_X86
+    if (kernel == KERNEL_AVX2) {
+        done = stepAVX2(dt);
+    }
+#endif
+#ifdef SESSION_BATCH_SSE2
+    if (kernel == KERNEL_SSE2) {
+        done = stepSSE2(dt);
+    }
+#endif
+    // SIMD の幅に満たない残りはスカラーで処理する
+    stepScalar(done, count, dt);
+}
+
+void SessionBatch::stepScalar(size_t begin, size_t end, int32_t dt) {
+    for (size_t i = begin; i < end; i++) {
+        int32_t n = now[i] + dt;
+        now[i] = n;
+
+        // プレイ中またはアニメーション中はタイマー更新
+        int32_t state = gameState[i];
+        if (state == STATE_PLAYING || state == STATE_MOVING) {
+            int32_t time = currentTime[i] - dt;
+            if (time <= 0) {
+                time = 0;
+                state = STATE_GAMEOVER;
+                gameState[i] = state;
+                gameOverTime[i] = n;
+            }
+            currentTime[i] = time;
+        }
+
+        // アニメーション中の位置更新と移動完了判定
+        if (state == STATE_MOVING) {
+            int32_t elapsed = n - moveStartTime[i];
+            float t = static_cast<float>(elapsed) / MOVE_DURATION;
+            if (t >= 1.0f) {
+                t = 1.0f;
+            }
+            playerX[i] = PLAYER_START_X + t * moveDX[i];
+            playerY[i] = PLAYER_START_Y + t * moveDY[i];
+
+            if (elapsed >= static_cast<int32_t>(MOVE_DURATION)) {
+                resolveMovement(i);
+            }
+        }
+    }
+}
+
+#ifdef SESSION_BATCH_SSE2
+
+size_t SessionBatch::stepSSE2(int32_t dt) {
+    const __m128i vdt = _mm_set1_epi32(dt);
+    const __m128i playing = _mm_set1_epi32(STATE_PLAYING);
+    const __m128i moving = _mm_set1_epi32(STATE_MOVING);
+    const __m128i gameover = _mm_set1_epi32(STATE_GAMEOVER);
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i lastMoveMs = _mm_set1_epi32(MOVE_DURATION - 1);
+    const __m128 duration = _mm_set1_ps(static_cast<float>(MOVE_DURATION));
+    const __m128 onef = _mm_set1_ps(1.0f);
+    const __m128 startX = _mm_set1_ps(PLAYER_START_X);
+    const __m128 startY = _mm_set1_ps(PLAYER_START_Y);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i n = _mm_add_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&now[i])), vdt);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&now[i]), n);
+
+        // タイマー更新（SSE2 には blend が無いので and/andnot/or で選ぶ）
+        __m128i state =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&gameState[i]));
+        __m128i active = _mm_or_si128(_mm_cmpeq_epi32(state, playing),
+                                      _mm_cmpeq_epi32(state, moving));
+        __m128i time = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(&currentTime[i]));
+        __m128i nextTime = _mm_sub_epi32(time, vdt);
+        __m128i timeout =
+            _mm_and_si128(active, _mm_cmplt_epi32(nextTime, one));
+        nextTime = _mm_andnot_si128(timeout, nextTime);  // 時間切れは0
+        time = _mm_or_si128(_mm_and_si128(active, nextTime),
+                            _mm_andnot_si128(active, time));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&currentTime[i]), time);
+
+        state = _mm_or_si128(_mm_and_si128(timeout, gameover),
+                             _mm_andnot_si128(timeout, state));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&gameState[i]), state);
+        __m128i overTime = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(&gameOverTime[i]));
+        overTime = _mm_or_si128(_mm_and_si128(timeout, n),
+                                _mm_andnot_si128(timeout, overTime));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&gameOverTime[i]),
+                         overTime);
+
+        // アニメーション中のセッションが無ければ次へ
+        __m128i isMoving = _mm_cmpeq_epi32(state, moving);
+        if (_mm_movemask_epi8(isMoving) == 0) {
+            continue;
+        }
+
+        __m128i elapsed = _mm_sub_epi32(
+            n, _mm_loadu_si128(
+                   reinterpret_cast<const __m128i*>(&moveStartTime[i])));
+        __m128 t = _mm_min_ps(
+            _mm_div_ps(_mm_cvtepi32_ps(elapsed), duration), onef);
+        __m128 x = _mm_add_ps(startX, _mm_mul_ps(t, _mm_loadu_ps(&moveDX[i])));
+        __m128 y = _mm_add_ps(startY, _mm_mul_ps(t, _mm_loadu_ps(&moveDY[i])));
+        __m128 movingMask = _mm_castsi128_ps(isMoving);
+        _mm_storeu_ps(&playerX[i],
+                      _mm_or_ps(_mm_and_ps(movingMask, x),
+                                _mm_andnot_ps(movingMask,
+                                              _mm_loadu_ps(&playerX[i]))));
+        _mm_storeu_ps(&playerY[i],
+                      _mm_or_ps(_mm_and_ps(movingMask, y),
+                                _mm_andnot_ps(movingMask,
+                                              _mm_loadu_ps(&playerY[i]))));
+
+        // 移動完了したセッションだけスカラーで衝突判定
+        __m128i complete =
+            _mm_and_si128(isMoving, _mm_cmpgt_epi32(elapsed, lastMoveMs));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(complete));
+        while (mask) {
+            int lane = __builtin_ctz(mask);
+            resolveMovement(i + lane);
+            mask &= mask - 1;
+        }
+    }
+    return i;
+}
+
+#endif
+
+#ifdef SESSION_BATCH_X86
+
+__attribute__((target("avx2"))) size_t SessionBatch::stepAVX2(int32_t dt) {
+    const __m256i vdt = _mm256_set1_epi32(dt);
+    const __m256i playing = _mm256_set1_epi32(STATE_PLAYING);
+    const __m256i moving = _mm256_set1_epi32(STATE_MOVING);
+    const __m256i gameover = _mm256_set1_epi32(STATE_GAMEOVER);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i lastMoveMs = _mm256_set1_epi32(MOVE_DURATION - 1);
+    const __m256 duration = _mm256_set1_ps(static_cast<float>(MOVE_DURATION));
+    const __m256 onef = _mm256_set1_ps(1.0f);
+    const __m256 startX = _mm256_set1_ps(PLAYER_START_X);
+    const __m256 startY = _mm256_set1_ps(PLAYER_START_Y);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i n = _mm256_add_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&now[i])),
+            vdt);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&now[i]), n);
+
+        // タイマー更新
+        __m256i state = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(&gameState[i]));
+        __m256i active = _mm256_or_si256(_mm256_cmpeq_epi32(state, playing),
+                                         _mm256_cmpeq_epi32(state, moving));
+        __m256i time = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(&currentTime[i]));
+        __m256i nextTime = _mm256_sub_epi32(time, vdt);
+        __m256i timeout =
+            _mm256_and_si256(active, _mm256_cmpgt_epi32(one, nextTime));
+        nextTime = _mm256_max_epi32(nextTime, zero);
+        time = _mm256_blendv_epi8(time, nextTime, active);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&currentTime[i]),
+                            time);
+
+        state = _mm256_blendv_epi8(state, gameover, timeout);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&gameState[i]), state);
+        __m256i overTime = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(&gameOverTime[i]));
+        overTime = _mm256_blendv_epi8(overTime, n, timeout);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&gameOverTime[i]),
+                            overTime);
+
+        // アニメーション中のセッションが無ければ次へ
+        __m256i isMoving = _mm256_cmpeq_epi32(state, moving);
+        if (_mm256_testz_si256(isMoving, isMoving)) {
+            continue;
+        }
+
+        __m256i elapsed = _mm256_sub_epi32(
+            n, _mm256_loadu_si256(
+                   reinterpret_cast<const __m256i*>(&moveStartTime[i])));
+        __m256 t = _mm256_min_ps(
+            _mm256_div_ps(_mm256_cvtepi32_ps(elapsed), duration), onef);
+        __m256 x = _mm256_add_ps(
+            startX, _mm256_mul_ps(t, _mm256_loadu_ps(&moveDX[i])));
+        __m256 y = _mm256_add_ps(
+            startY, _mm256_mul_ps(t, _mm256_loadu_ps(&moveDY[i])));
+        __m256 movingMask = _mm256_castsi256_ps(isMoving);
+        _mm256_storeu_ps(&playerX[i], _mm256_blendv_ps(
+                                          _mm256_loadu_ps(&playerX[i]), x,
+                                          movingMask));
+        _mm256_storeu_ps(&playerY[i], _mm256_blendv_ps(
+                                          _mm256_loadu_ps(&playerY[i]), y,
+                                          movingMask));
+
+        // 移動完了したセッションだけスカラーで衝突判定
+        __m256i complete = _mm256_and_si256(
+            isMoving, _mm256_cmpgt_epi32(elapsed, lastMoveMs));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(complete));
+        while (mask) {
+            int lane = __builtin_ctz(mask);
+            resolveMovement(i + lane);
+            mask &= mask - 1;
+        }
+    }
+    return i;
+}
+
+#endif
@@ -0,0 +1,97 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "Random.h"
+#include "Rules.h"
+#include "Simulation.h"
+
+// 多数のセッションを配列の束（Struct of Arrays）として保持し、
+// タイマーと移動アニメーションを SIMD でまとめて進める（SDLに依存しない）
+//
+// 1セッションごとに Game（ウィンドウ・レンダラー・フォントを持つ）を
+// 作るのは重すぎるため、サーバー側でのスコア検証などで使う。
+// ルールは stepSimulation と同じで、同じシード・入力なら同じ結果になる
+//
+// step() の処理
+//   1. SIMD カーネル（AVX2 で8セッション、SSE2 で4セッションずつ）
+//      時刻・残り時間・時間切れ・プレイヤー位置・移動完了の判定
+//   2. 移動が完了したセッションだけスカラーで衝突判定と次ラウンドの準備
+// x86 以外や古いCPUではスカラー版のカーネルを使う
+class SessionBatch {
+   public:
+    // 使用する SIMD 命令セット
+    enum Kernel { KERNEL_SCALAR, KERNEL_SSE2, KERNEL_AVX2 };
+
+    SessionBatch();
+
+    // 新しいセッションを追加し、resetRound 済みの状態にする
+    // 戻り値はセッション番号
+    size_t add(uint64_t seed);
+    void clear();
+    size_t size() const { return count; }
+
+    // セッション i に入力を適用する（stepSimulation の入力処理と同じ）
+    // dtMs は次の step に渡す値。input.offsetMs が dtMs 以上なら 0 とみなす
+    void applyInput(size_t i, const SimInput& input, uint32_t dtMs);
+
+    // 全セッションの時間を dtMs ミリ秒進める
+    void step(uint32_t dtMs);
+
+    // 使用するカーネルを指定する（CPUが対応していなければ無視）
+    void setKernel(Kernel kernel);
+    Kernel getKernel() const { return kernel; }
+
+    // アクセサ
+    GameState getState(size_t i) const {
+        return static_cast<GameState>(gameState[i]);
+    }
+    int getScore(size_t i) const { return score[i]; }
+    int getCurrentTime(size_t i) const { return currentTime[i]; }
+    int getCurrentMaxTime(size_t i) const { return currentMaxTime[i]; }
+    uint32_t getNow(size_t i) const { return static_cast<uint32_t>(now[i]); }
+    uint32_t getGameOverTime(size_t i) const {
+        return static_cast<uint32_t>(gameOverTime[i]);
+    }
+    RoundDescriptor getRound(size_t i) const { return round[i]; }
+    float getPlayerX(size_t i) const { return playerX[i]; }
+    float getPlayerY(size_t i) const { return playerY[i]; }
+    bool isFinished(size_t i) const {
+        return gameState[i] == STATE_GAMEOVER &&
+               getNow(i) - getGameOverTime(i) >= GAMEOVER_HOLD_TIME;
+    }
+
+   private:
+    void resolveMovement(size_t i);
+
+    void stepScalar(size_t begin, size_t end, int32_t dt);
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+    size_t stepSSE2(int32_t dt);
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+    size_t stepAVX2(int32_t dt);
+#endif
+
+    size_t count;
+    Kernel kernel;
+
+    // セッションごとの値（同じ番号が同じセッション）
+    // SIMD で扱う値は32ビット幅にそろえる
+    std::vector<int32_t> gameState;
+    std::vector<int32_t> now;
+    std::vector<int32_t> gameOverTime;
+    std::vector<int32_t> currentTime;
+    std::vector<int32_t> currentMaxTime;
+    std::vector<int32_t> moveStartTime;
+    std::vector<float> playerX, playerY;
+    std::vector<float> moveDX, moveDY;  // 移動先までの差分
+
+    // 移動完了時だけ使う値
+    std::vector<int32_t> score;
+    std::vector<int32_t> successCount;
+    std::vector<RoundDescriptor> round;  // 壁と指示色（16ビット）
+    std::vector<uint8_t> moveDir;
+    std::vector<Random> rng;
+};
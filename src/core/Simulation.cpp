@@ -0,0 +1,116 @@
+#include "Simulation.h"
+
+SimState::SimState()
+    : gameState(STATE_COUNTDOWN),
+      now(0),
+      gameOverTime(0),
+      score(0),
+      successCount(0),
+      currentTime(INITIAL_MAX_TIME),
+      currentMaxTime(INITIAL_MAX_TIME),
+      round(0) {}
+
+void resetRound(SimState& state) {
+    // プレイヤー位置を中央に
+    state.player.reset();
+
+    // スコア初期化
+    state.score = 0;
+    state.successCount = 0;
+
+    // タイマー初期化
+    state.currentTime = INITIAL_MAX_TIME;
+    state.currentMaxTime = INITIAL_MAX_TIME;
+
+    // 色をランダムに設定
+    randomizeColors(state);
+
+    // ゲーム状態設定
+    state.gameState = STATE_PLAYING;
+}
+
+void randomizeColors(SimState& state) {
+    state.round = drawRound(state.rng.next());
+}
+
+int nextMaxTime(int currentMaxTime, int successCount) {
+    // 5回成功するたびにタイマー制限を厳しくする
+    if (successCount % DIFFICULTY_STEP_COUNT == 0) {
+        currentMaxTime -= DIFFICULTY_STEP_TIME;
+        if (currentMaxTime < MIN_MAX_TIME) {
+            currentMaxTime = MIN_MAX_TIME;
+        }
+    }
+    return currentMaxTime;
+}
+
+static void setGameOver(SimState& state) {
+    state.gameState = STATE_GAMEOVER;
+    state.gameOverTime = state.now;
+}
+
+void stepSimulation(SimState& state, const SimInput& input, uint32_t dtMs) {
+    // 終了要求
+    if (input.quit && state.gameState != STATE_GAMEOVER) {
+        setGameOver(state);
+    }
+
+    // 入力はプレイ中かつ移動中でない場合のみ受け付ける
+    // 入力の時刻で既に時間切れなら受け付けない（このステップで時間切れ）
+    uint32_t offset = input.offsetMs < dtMs ? input.offsetMs : 0;
+    if (state.gameState == STATE_PLAYING && input.dir != DIR_NONE &&
+        !state.player.isMoving() &&
+        state.currentTime > static_cast<int>(offset)) {
+        state.player.setMovementTarget(input.dir, state.now + offset);
+        state.gameState = STATE_MOVING;
+    }
+
+    // 時刻を進める
+    state.now += dtMs;
+
+    // プレイ中またはアニメーション中はタイマー更新
+    if (state.gameState == STATE_PLAYING || state.gameState == STATE_MOVING) {
+        state.currentTime -= static_cast<int>(dtMs);
+
+        // タイムアップ判定
+        if (state.currentTime <= 0) {
+            state.currentTime = 0;
+            setGameOver(state);
+        }
+    }
+
+    // アニメーション中の更新処理
+    if (state.gameState == STATE_MOVING) {
+        // プレイヤーの位置更新
+        state.player.update(state.now);
+
+        // 移動完了判定
+        if (state.player.isMovementComplete(state.now)) {
+            // 衝突判定：正しい壁に接触したか
+            if (state.player.checkCollision(state.player.getMoveDir(),
+                                            state.round)) {
+                // 成功
+                state.score++;
+                state.successCount++;
+
+                // 成功回数に応じてタイマー制限を厳しくする
+                state.currentMaxTime =
+                    nextMaxTime(state.currentMaxTime, state.successCount);
+
+                // 次ラウンドの準備
+                state.player.reset();
+                state.currentTime = state.currentMaxTime;
+                randomizeColors(state);
+                state.gameState = STATE_PLAYING;
+            } else {
+                // 失敗（ゲームオーバー）
+                setGameOver(state);
+            }
+        }
+    }
+}
+
+bool isSessionFinished(const SimState& state) {
+    return state.gameState == STATE_GAMEOVER &&
+           state.now - state.gameOverTime >= GAMEOVER_HOLD_TIME;
+}
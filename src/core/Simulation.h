@@ -0,0 +1,62 @@
+#pragma once
+#include <stdint.h>
+
+#include "Player.h"
+#include "Random.h"
+#include "RoundColors.h"
+#include "Rules.h"
+
+// 1ステップ分の入力
+struct SimInput {
+    Direction dir;  // 受け付ける移動方向（無ければ DIR_NONE）
+    bool quit;      // 終了要求
+    // 入力が起きた時刻（ステップ開始からのミリ秒、dtMs 未満）
+    // 移動開始と残り時間の判定をステップの途中の時刻で行う
+    uint32_t offsetMs;
+
+    SimInput() : dir(DIR_NONE), quit(false), offsetMs(0) {}
+};
+
+// ゲーム全体の状態（SDLに依存しない）
+// 色は colorSet のインデックス（2ビット）を詰めた記述子で保持する
+struct SimState {
+    // ゲーム状態
+    GameState gameState;
+    uint32_t now;           // シミュレーション時刻（ミリ秒）
+    uint32_t gameOverTime;  // ゲームオーバーになった時刻
+
+    // スコア関連
+    int score;
+    int successCount;
+
+    // タイマー関連（ミリ秒）
+    int currentTime;
+    int currentMaxTime;
+
+    // 色関連（4枚の壁と指示色）
+    RoundDescriptor round;
+
+    // プレイヤー
+    Player player;
+
+    // このセッション専用の乱数生成器
+    Random rng;
+
+    SimState();
+};
+
+// ラウンド（1ゲーム）を初期状態にする。時刻 now は維持する
+void resetRound(SimState& state);
+
+// 入力を適用し、時間を dtMs ミリ秒進める
+// 同じ状態・入力・dtMs からは常に同じ結果になる
+void stepSimulation(SimState& state, const SimInput& input, uint32_t dtMs);
+
+// ゲームオーバー表示の保持時間が過ぎたか
+bool isSessionFinished(const SimState& state);
+
+// 指示色と4枚の壁の色を、乱数1回分（64ビット）からまとめて決める
+void randomizeColors(SimState& state);
+
+// 成功回数 successCount に達した時点での次の制限時間（ミリ秒）
+int nextMaxTime(int currentMaxTime, int successCount);
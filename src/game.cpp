@@ -1,23 +1,79 @@
 #include "game.h"
 
-#include <cstdlib>
-#include <ctime>
-#include <sstream>
+#include <cstdio>
 
+#include "AllocationCheck.h"
 #include "Constants.h"
-#include "Player.h"
-#include "Utility.h"
+#include "PlayerRenderer.h"
+#include "ProfileZones.h"
+
+// フォントの候補（優先順。--font の指定があればその後ろに続ける）
+static const char* const DEFAULT_FONT_FILES[] = {
+    "Arial.ttf", "Helvetica.ttc", "DejaVuSans.ttf",
+    "LiberationSans-Regular.ttf", "arial.ttf"};
+
+// フォントを探す OS ごとの既定のディレクトリ
+static const char* const DEFAULT_FONT_DIRS[] = {
+    "/System/Library/Fonts/Supplemental",
+    "/System/Library/Fonts",
+    "/usr/share/fonts/truetype/dejavu",
+    "/usr/share/fonts/truetype/liberation",
+    "/usr/share/fonts/TTF",
+    "C:/Windows/Fonts"};
+
+// F2 で書き出すトレースの既定のファイル名（--trace で変更）
+static const char* const DEFAULT_TRACE_PATH = "trace.json";
+
+// ALLOC_CHECK ビルドで、ゲーム開始後このフレーム数を描いたら
+// 定常状態とみなしてヒープ確保を禁止する
+static const int ALLOC_CHECK_WARMUP_FRAMES = 120;
+
+// 開始前のカウントダウンで順に表示するラベル（最後は緑）
+static const char* const COUNTDOWN_LABELS[] = {"3", "2", "1", "Go!"};
+static const int COUNTDOWN_STEPS =
+    sizeof(COUNTDOWN_LABELS) / sizeof(COUNTDOWN_LABELS[0]);
 
 Game::Game()
     : window(nullptr),
       renderer(nullptr),
+      headless(false),
       font(nullptr),
-      gameState(STATE_COUNTDOWN),
-      gameOverTime(0),
-      score(0),
-      successCount(0),
-      currentTime(INITIAL_MAX_TIME),
-      currentMaxTime(INITIAL_MAX_TIME),
+      assetEventType(0),
+      assetsReady(false),
+      firstFramePresented(false),
+      backend(nullptr),
+      softwareRaster(false),
+      staticLayerValid(false),
+      staticLayerRound(0),
+      staticLayerScore(0),
+      formattedScore(-1),
+      quitRequested(false),
+      simThread(nullptr),
+      simStopRequested(false),
+      simRunning(false),
+      simLastCounter(0),
+      simAccumulator(0),
+      inputStampPending(false),
+      lastInputSerial(0),
+      countdownStart(0),
+      countdownStep(0),
+      tickMs(1000 / DEFAULT_TICK_RATE),
+      tickCount(0),
+      vsyncEnabled(false),
+      randomSeed(0),
+      replayMode(false),
+      prevPlayerX(0),
+      prevPlayerY(0),
+      updateMicros(0),
+      idleWait(true),
+      frameDirty(true),
+      lastFrame(),
+      metricsFrameCounter(0),
+      showLatencyOverlay(false),
+      botEnabled(false),
+      bot(BotConfig(), 0),
+      soakDuration(0),
+      windowClosed(false),
       lastBlinkTime(0),
       blinkOn(false) {
     // 壁の矩形初期化
@@ -34,7 +90,24 @@ Game::Game()
 }
 
 Game::~Game() {
-    // リソース解放
+    // シミュレーション・読み込みスレッドを止めてからリソースを解放する
+    stopSimulation();
+    assetLoader.stop();
+    if (!assetsReady) {
+        // 受け取られなかった読み込み結果
+        if (fontLoad.atlas.surface) {
+            SDL_FreeSurface(fontLoad.atlas.surface);
+        }
+        if (fontLoad.countdown.surface) {
+            SDL_FreeSurface(fontLoad.countdown.surface);
+        }
+        font = fontLoad.font;
+    }
+    textRenderer.destroy();
+    playerSprite.destroy();
+    countdownLabels.destroy();
+    softwareRasterizer.destroy();
+    sdlBackend.destroy();
     if (font) {
         TTF_CloseFont(font);
     }
@@ -51,11 +124,23 @@ Game::~Game() {
 }
 
 bool Game::initialize() {
+    startupProfile.begin();
+
+    // ALLOC_CHECK ビルドでは SDL 内部の確保も数える
+    installAllocationHooks();
+
+    // 画面を持たない環境（回帰テストや夜間の連続実行）
+    if (headless) {
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    }
+
     // SDL初期化
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) != 0) {
         SDL_Log("SDL_Init Error: %s", SDL_GetError());
         return false;
     }
+    startupProfile.mark("SDL_Init");
 
     // SDL_ttf初期化
     if (TTF_Init() != 0) {
@@ -63,6 +148,11 @@ bool Game::initialize() {
         SDL_Quit();
         return false;
     }
+    startupProfile.mark("TTF_Init");
+
+    // フォントの読み込みは別スレッドで進め、その間にウィンドウを作る
+    startAssetLoading();
+    startupProfile.mark("loader start");
 
     // ウィンドウ作成
     window = SDL_CreateWindow("Wall Color Game", SDL_WINDOWPOS_CENTERED,
@@ -70,448 +160,1269 @@ bool Game::initialize() {
                               WINDOW_HEIGHT, SDL_WINDOW_SHOWN);
     if (!window) {
         SDL_Log("SDL_CreateWindow Error: %s", SDL_GetError());
-        TTF_Quit();
-        SDL_Quit();
         return false;
     }
+    startupProfile.mark("window");
 
-    // レンダラー作成
-    renderer = SDL_CreateRenderer(
-        window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    // レンダラー作成（再生・自動プレイヤーは最大速度で回すためVSyncを切る）
+    Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+    if (!replayMode && !botEnabled) {
+        rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+    }
+    MemorySample beforeRenderer = sampleMemory();
+    renderer = SDL_CreateRenderer(window, -1, rendererFlags);
     if (!renderer) {
         SDL_Log("SDL_CreateRenderer Error: %s", SDL_GetError());
-        SDL_DestroyWindow(window);
-        TTF_Quit();
-        SDL_Quit();
         return false;
     }
 
-    // フォント読み込み
-    font = TTF_OpenFont("/System/Library/Fonts/Supplemental/Arial.ttf", 24);
-    if (!font) {
-        // 代替フォントを試す
-        font = TTF_OpenFont("/System/Library/Fonts/Helvetica.ttc", 24);
-        if (!font) {
-            SDL_Log("TTF_OpenFont Error: %s", TTF_GetError());
-            SDL_DestroyRenderer(renderer);
-            SDL_DestroyWindow(window);
-            TTF_Quit();
-            SDL_Quit();
-            return false;
+    // ドライバがレンダラーの作成で確保した分（読み込みスレッドの分も混ざる）
+    MemorySample afterRenderer = sampleMemory();
+    SDL_Log("Renderer memory: heap %+.1f MB, RSS %+.1f MB",
+            (static_cast<double>(afterRenderer.heapBytes) -
+             beforeRenderer.heapBytes) / (1024.0 * 1024.0),
+            (static_cast<double>(afterRenderer.residentBytes) -
+             beforeRenderer.residentBytes) / (1024.0 * 1024.0));
+
+    // VSyncが効いていればフレームの待ちは SDL_RenderPresent に任せる
+    SDL_RendererInfo rendererInfo;
+    if (SDL_GetRendererInfo(renderer, &rendererInfo) == 0) {
+        vsyncEnabled = (rendererInfo.flags & SDL_RENDERER_PRESENTVSYNC) != 0;
+    }
+
+    // 描画の出力先（--software-raster なら CPU のフレームバッファ）
+    sdlBackend.initialize(renderer);
+    backend = &sdlBackend;
+    if (softwareRaster) {
+        if (softwareRasterizer.initialize(renderer, WINDOW_WIDTH,
+                                          WINDOW_HEIGHT)) {
+            backend = &softwareRasterizer;
+        } else {
+            SDL_Log("Software rasterizer unavailable; using SDL_Renderer");
         }
     }
+    startupProfile.mark("renderer");
+
+    // プレイヤーの円をテクスチャに焼き込む
+    if (!playerSprite.create(backend, PLAYER_RADIUS)) {
+        SDL_Log("CircleSprite creation failed");
+    }
+    startupProfile.mark("sprite");
 
     // ゲームの初期設定
     initRound();
+    publishSnapshot(SDL_GetPerformanceCounter());
+    acquireSnapshot();
+
+    // 読み込みが先に終わっていればすぐ使う
+    pollAssets();
+
+    return true;
+}
+
+void Game::startAssetLoading() {
+    // 読み込みの完了でイベント待ちから起こすためのイベント
+    assetEventType = SDL_RegisterEvents(1);
+    if (assetEventType == static_cast<Uint32>(-1)) {
+        assetEventType = 0;
+    }
+
+    // 探す順：--asset-dir → 実行ファイル横の assets/fonts → OS の既定
+    char* basePath = SDL_GetBasePath();
+    if (basePath) {
+        assetLoader.addSearchPath(std::string(basePath) + "assets/fonts");
+        SDL_free(basePath);
+    }
+    for (size_t i = 0; i < sizeof(DEFAULT_FONT_DIRS) / sizeof(char*); i++) {
+        assetLoader.addSearchPath(DEFAULT_FONT_DIRS[i]);
+    }
+
+    if (assetLoader.start(assetEventType)) {
+        assetLoader.enqueue([this]() { loadFont(); });
+    } else {
+        // スレッドが使えない環境ではその場で読み込む
+        loadFont();
+    }
+}
+
+void Game::loadFont() {
+    // 読み込みスレッドで実行される
+    // 結果は fontLoad に書き、最後に ready を立ててメインスレッドへ渡す
+    PROFILE_THREAD_NAME("assets");
+    PROFILE_ZONE("Game::loadFont");
+    std::vector<std::string> names;
+    if (!fontPath.empty()) {
+        names.push_back(fontPath);
+    }
+    for (size_t i = 0; i < sizeof(DEFAULT_FONT_FILES) / sizeof(char*); i++) {
+        names.push_back(DEFAULT_FONT_FILES[i]);
+    }
+    std::vector<std::string> candidates = assetLoader.findFiles(names);
+
+    // 候補を順に試し、開けた最初のフォントを使う
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 openStart = SDL_GetPerformanceCounter();
+    for (size_t i = 0; i < candidates.size() && !fontLoad.font; i++) {
+        fontLoad.font = TTF_OpenFont(candidates[i].c_str(), FONT_SIZE);
+        if (fontLoad.font) {
+            fontLoad.path = candidates[i];
+        } else {
+            SDL_Log("TTF_OpenFont Error: %s", TTF_GetError());
+        }
+    }
+    Uint64 bakeStart = SDL_GetPerformanceCounter();
+    fontLoad.openMs =
+        static_cast<float>((bakeStart - openStart) * 1000.0 / frequency);
+
+    // グリフアトラスとカウントダウンの数字の画像もここで作る
+    // （テクスチャ化はメインスレッド）
+    if (fontLoad.font) {
+        bakeGlyphAtlas(fontLoad.font, fontLoad.atlas);
+
+        TTF_Font* large =
+            TTF_OpenFont(fontLoad.path.c_str(), COUNTDOWN_FONT_SIZE);
+        if (large) {
+            bakeLabels(large, COUNTDOWN_LABELS, COUNTDOWN_STEPS,
+                       fontLoad.countdown);
+            TTF_CloseFont(large);
+        } else {
+            SDL_Log("TTF_OpenFont Error: %s", TTF_GetError());
+        }
+    }
+    fontLoad.bakeMs = static_cast<float>(
+        (SDL_GetPerformanceCounter() - bakeStart) * 1000.0 / frequency);
+
+    SDL_AtomicSet(&fontLoad.ready, 1);
+}
+
+void Game::pollAssets() {
+    if (assetsReady || SDL_AtomicGet(&fontLoad.ready) == 0) {
+        return;
+    }
+    assetsReady = true;
+    startupProfile.addBackground("font open", fontLoad.openMs);
+    startupProfile.addBackground("atlas bake", fontLoad.bakeMs);
+
+    font = fontLoad.font;
+    if (!font) {
+        SDL_Log("No usable font found; text is disabled (use --font)");
+    } else if (!textRenderer.initialize(backend, fontLoad.atlas)) {
+        SDL_Log("TextRenderer initialization failed");
+    }
+    if (fontLoad.countdown.surface &&
+        !countdownLabels.initialize(backend, fontLoad.countdown)) {
+        SDL_Log("Countdown label initialization failed");
+    }
+
+    // 文字を含む画面を描き直す
+    staticLayerValid = false;
+    frameDirty = true;
+
+    startupProfile.mark("assets ready");
+    if (firstFramePresented) {
+        startupProfile.report();
+    }
+}
+
+bool Game::finishLoadingAssets() {
+    assetLoader.waitIdle();
+    pollAssets();
+    return textRenderer.isReady();
+}
+
+void Game::markFramePresented() {
+    if (firstFramePresented) {
+        return;
+    }
+    firstFramePresented = true;
+    startupProfile.mark("first frame");
+    if (assetsReady) {
+        startupProfile.report();
+    }
+}
+
+void Game::setTickRate(int ticksPerSecond) {
+    // ティック長は整数ミリ秒なので、1000 を割り切れるレートだけ受け付ける
+    // （60Hz などは切り捨てで別のレートになってしまう）
+    if (ticksPerSecond <= 0 || ticksPerSecond > 1000 ||
+        1000 % ticksPerSecond != 0) {
+        SDL_Log("Invalid tick rate %d Hz (must divide 1000), keeping %u Hz "
+                "(%u ms)",
+                ticksPerSecond, 1000 / tickMs, tickMs);
+        return;
+    }
+    tickMs = 1000 / ticksPerSecond;
+    SDL_Log("Tick rate: %d Hz (%u ms)", ticksPerSecond, tickMs);
+}
+
+void Game::setRandomSeed(Uint32 seed) {
+    randomSeed = seed;
+    sim.rng.seed(seed);
+}
+
+void Game::setBot(const BotConfig& config) {
+    botEnabled = true;
+    botConfig = config;
+    idleWait = false;
+}
+
+void Game::setSoakMinutes(int minutes) {
+    soakDuration = minutes > 0 ? static_cast<Uint32>(minutes) * 60000 : 0;
+}
+
+bool Game::loadReplay(const std::string& path) {
+    if (!recording.load(path.c_str())) {
+        SDL_Log("Failed to load replay: %s", path.c_str());
+        return false;
+    }
 
+    // 記録時と同じシード・ティック長で再現する
+    setRandomSeed(recording.getSeed());
+    tickMs = recording.getTickMs();
+    replayMode = true;
     return true;
 }
 
 void Game::runGame() {
+    if (replayMode) {
+        runReplay();
+        return;
+    }
+    if (captureConfig.isEnabled()) {
+        startBotCapture();
+    }
+
+    // 入力の記録を開始
+    recording.reset(randomSeed, tickMs);
+
+    // 自動プレイヤーの乱数はシミュレーションとは別の系列にする
+    if (botEnabled) {
+        bot = BotPlayer(botConfig, ~static_cast<Uint64>(randomSeed));
+        soakStats.start(SDL_GetTicks());
+    }
+
     // ゲームループの変数
     bool quit = false;
-    Uint32 lastTime = SDL_GetTicks();
-    const float deltaTimeStep = 1.0f / 60.0f;  // 60fps想定
+    int warmupFrames = 0;
+    bool steadyState = false;
+
+    // 描画の補間と待ち時間は最後に公開されたティックからの経過時間で決める
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    const Uint64 tickCounts = frequency * tickMs / 1000;
+
+    pacingStats.start(SDL_GetTicks());
+    memoryTelemetry.start(SDL_GetTicks());
+    frameDirty = true;
+
+    // 監視ツール向けの共有メモリ（以降は書き込むだけ）
+    if (!metricsName.empty()) {
+        metricsPublisher.open(metricsName);
+    }
 
-    // メインゲームループ
+    // 移動入力はイベントがキューに入った時点で時刻付きで取り込む
+    SDL_AddEventWatch(captureInput, this);
+
+    PROFILE_THREAD_NAME("main");
+
+    // 「3 → 2 → 1 → Go!」もこのループの1状態として描く
+    // シミュレーションスレッドはカウントダウンが終わってから動かす
+    startCountdown();
+
+    // メインゲームループ（イベント処理と描画）
+    // 時間を進めるのはシミュレーションスレッドで、ここでは最後に公開された
+    // 状態を描く。画面に変化が無い間は SDL_WaitEventTimeout で眠り、次に
+    // 見た目が変わる時刻（ゲージの1ピクセル・点滅・アニメーション）か
+    // イベントで起きる
     while (!quit) {
-        // デルタタイム計算
-        Uint32 currentTime = SDL_GetTicks();
-        float deltaTime = (currentTime - lastTime) / 1000.0f;
-        lastTime = currentTime;
+        // 届いている入力を取り込む
+        SDL_PumpEvents();
+        pacingStats.countWakeup(SDL_GetTicks());
+
+        if (!simRunning) {
+            updateCountdown();
+        } else if (!simThread) {
+            // スレッドを作れなかった環境ではこのループで時間を進める
+            advanceSimulation(SDL_GetPerformanceCounter());
+        }
 
-        // イベント処理
+        // イベント処理（受け付けた入力は次のティックで適用する）
         handleEvents();
+        pollAssets();
 
-        // 更新
-        update(deltaTime);
+        // カウントダウン中の終了はシミュレーションを通さずに抜ける
+        if (!simRunning && quitRequested.load()) {
+            quit = true;
+            break;
+        }
 
-        // 描画
-        render();
+        // 最後に公開された状態を受け取る
+        acquireSnapshot();
+        Uint64 counter = SDL_GetPerformanceCounter();
+        Uint64 sinceTick =
+            counter > view.tickCounter ? counter - view.tickCounter : 0;
+
+        // 描画（ティック間の位置を補間）。見た目が変わるときだけ描く
+        updateBlink();
+        bool rendered = !idleWait || needsRedraw();
+        Uint64 renderStart = 0, renderEnd = 0;
+        if (rendered) {
+            float alpha = sinceTick < tickCounts
+                              ? static_cast<float>(sinceTick) / tickCounts
+                              : 1.0f;
+            renderStart = SDL_GetPerformanceCounter();
+            render(alpha);
+            renderEnd = SDL_GetPerformanceCounter();
+            markFramePresented();
+            lastFrame = getFrameSignature();
+            frameDirty = false;
+            pacingStats.countFrame();
+            if (botEnabled) {
+                soakStats.addFrame(SDL_GetPerformanceCounter());
+            }
+            if (simRunning && assetsReady) {
+                warmupFrames++;
+            }
+        }
+
+        // 定常状態に入ったら以降のヒープ確保を禁止する（ALLOC_CHECK ビルド）
+        // （フレームの取り込み中は作業スレッドが保存のために確保するので除く）
+        if (!steadyState && warmupFrames >= ALLOC_CHECK_WARMUP_FRAMES &&
+            !frameCapture.isRunning()) {
+            steadyState = true;
+            setAllocationsForbidden(true);
+        }
+
+        // メモリ使用量の標本（毎秒）と途中経過のログ
+        // ログの確保は定常状態の検査から外す
+        bool sampled = memoryTelemetry.update(SDL_GetTicks());
+        if (memoryTelemetry.isLogDue(SDL_GetTicks())) {
+            setAllocationsForbidden(false);
+            memoryTelemetry.logUsage(SDL_GetTicks());
+            setAllocationsForbidden(steadyState);
+        }
+        if (botEnabled && soakStats.isReportDue(SDL_GetTicks())) {
+            setAllocationsForbidden(false);
+            soakStats.reportWindow(SDL_GetTicks());
+            setAllocationsForbidden(steadyState);
+        }
+
+        // 監視ツール向けのメトリクス（共有メモリへの書き込みだけ）
+        publishMetrics(rendered, renderStart, renderEnd, sampled);
 
         // ゲームオーバー時の処理
-        if (gameState == STATE_GAMEOVER &&
-            (SDL_GetTicks() - gameOverTime >= 2000)) {
+        if (view.isSessionFinished()) {
+            if (botEnabled) {
+                soakStats.addSession(view.score);
+            }
+            // 時間が残っていれば次のセッションへ（終了操作があれば終わる）
+            if (botEnabled && !windowClosed &&
+                soakStats.getElapsed(SDL_GetTicks()) < soakDuration) {
+                setAllocationsForbidden(false);
+                restartSession();
+                setAllocationsForbidden(steadyState);
+                continue;
+            }
             quit = true;
+            break;
         }
 
-        // フレームレート調整
-        SDL_Delay(16);  // 約60FPS
+        if (!idleWait) {
+            // VSyncが無い環境では空回りしないよう少し休む
+            // （自動プレイヤーは描画の上限を測るため休まない）
+            if (!vsyncEnabled && !botEnabled) {
+                SDL_Delay(1);
+            }
+            continue;
+        }
+
+        // 次に何かが変わるまで眠る（入力があればすぐ起きる）
+        Uint32 sinceTickMs = static_cast<Uint32>(sinceTick * 1000 / frequency);
+        Uint32 waitMs = getIdleWait(sinceTickMs);
+        if (waitMs > 0) {
+            PROFILE_ZONE("idle wait");
+            SDL_WaitEventTimeout(nullptr, static_cast<int>(waitMs));
+        }
+    }
+
+    // 終了処理（ログ・ファイル出力）では確保してよい
+    setAllocationsForbidden(false);
+
+    // 以降は sim をこのスレッドで読む
+    stopSimulation();
+    SDL_DelEventWatch(captureInput, this);
+    metricsPublisher.close();
+
+    float wakeupsPerSecond, framesPerSecond;
+    pacingStats.getAverages(SDL_GetTicks(), wakeupsPerSecond, framesPerSecond);
+    SDL_Log("Frame pacing: %.1f wakeups/s, %.1f frames/s", wakeupsPerSecond,
+            framesPerSecond);
+    memoryTelemetry.logUsage(SDL_GetTicks());
+    if (botEnabled) {
+        soakStats.reportTotal(SDL_GetTicks());
+    }
+    frameCapture.stop();
+
+    // 入力遅延の計測結果を出力
+    if (!latencyCsvPath.empty()) {
+        latencyProbe.writeCsv(latencyCsvPath.c_str());
+    }
+
+    // 区間計測のトレースを出力
+    if (!tracePath.empty()) {
+        writeTrace();
+    }
+
+    // 入力の記録を保存
+    if (!recordPath.empty()) {
+        recording.setResult(tickCount, sim.score);
+        if (!recording.save(recordPath.c_str())) {
+            SDL_Log("Failed to save recording: %s", recordPath.c_str());
+        }
     }
 }
 
-void Game::initRound() {
-    // プレイヤー位置を中央に
-    player.reset();
+void Game::restartSession() {
+    // 前のセッションのスレッドを止めてから sim をこのスレッドで初期化する
+    stopSimulation();
+
+    // 次のセッションは別のシードで、カウントダウンを挟まずに始める
+    // （記録は最後のセッションだけが残る）
+    setRandomSeed(randomSeed + 1);
+    recording.reset(randomSeed, tickMs);
+    tickCount = 0;
+    bot = BotPlayer(botConfig, ~static_cast<Uint64>(randomSeed));
+    pendingInput = SimInput();
+    initRound();
+    frameDirty = true;
 
-    // スコア初期化
-    score = 0;
-    successCount = 0;
+    sim.gameState = STATE_PLAYING;
+    publishSnapshot(SDL_GetPerformanceCounter());
+    if (!startSimulation()) {
+        SDL_Log("Running the simulation on the main thread");
+    }
+}
 
-    // タイマー初期化
-    currentTime = INITIAL_MAX_TIME;
-    currentMaxTime = INITIAL_MAX_TIME;
-    lastBlinkTime = SDL_GetTicks();
-    blinkOn = false;
+bool Game::startSimulation() {
+    simRunning = true;
+    simLastCounter = SDL_GetPerformanceCounter();
+    simAccumulator = 0;
+    simStopRequested.store(false);
 
-    // 色をランダムに設定
-    directiveColor = getRandomColor();
-    randomizeWallColors();
+    simThread = SDL_CreateThread(simulationThreadMain, "simulation", this);
+    if (!simThread) {
+        SDL_Log("SDL_CreateThread Error: %s", SDL_GetError());
+        return false;
+    }
+    return true;
+}
 
-    // ゲーム状態設定
-    gameState = STATE_PLAYING;
+void Game::stopSimulation() {
+    if (!simThread) {
+        return;
+    }
+    simStopRequested.store(true);
+    SDL_WaitThread(simThread, nullptr);
+    simThread = nullptr;
 }
 
-void Game::runCountdown() {
-    // カウントダウン表示（3, 2, 1, Go!）
-    int countdown = 3;
-    Uint32 lastCountdownTime = SDL_GetTicks();
+int Game::simulationThreadMain(void* data) {
+    static_cast<Game*>(data)->runSimulation();
+    return 0;
+}
 
-    while (countdown > 0) {
-        // イベント処理
-        SDL_Event e;
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_QUIT) {
-                gameState = STATE_GAMEOVER;
-                return;
-            }
-        }
+void Game::runSimulation() {
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    const Uint64 tickCounts = frequency * tickMs / 1000;
+    PROFILE_THREAD_NAME("simulation");
 
-        // 1秒ごとにカウントダウン
-        Uint32 currentTime = SDL_GetTicks();
-        if (currentTime - lastCountdownTime >= 1000) {
-            countdown--;
-            lastCountdownTime = currentTime;
-        }
+    while (!simStopRequested.load() && !isSessionFinished(sim)) {
+        advanceSimulation(SDL_GetPerformanceCounter());
 
-        // 背景描画
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderClear(renderer);
-
-        // カウントダウン表示
-        std::stringstream ss;
-        ss << countdown;
-        int textW, textH;
-        SDL_Texture* countdownTex = renderText(ss.str(), WHITE, textW, textH);
-        if (countdownTex) {
-            SDL_Rect dst = {WINDOW_WIDTH / 2 - textW / 2,
-                            WINDOW_HEIGHT / 2 - textH / 2, textW, textH};
-            SDL_RenderCopy(renderer, countdownTex, nullptr, &dst);
-            SDL_DestroyTexture(countdownTex);
-        }
+        // 次のティックの時刻まで眠る
+        Uint64 untilTick =
+            simAccumulator < tickCounts ? tickCounts - simAccumulator : 0;
+        Uint32 waitMs = static_cast<Uint32>(untilTick * 1000 / frequency);
+        SDL_Delay(waitMs > 0 ? waitMs : 1);
+    }
+}
+
+void Game::advanceSimulation(Uint64 counter) {
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    const Uint64 tickCounts = frequency * tickMs / 1000;
+    // 長い停止の後に大量のティックを一度に処理しないための上限
+    const Uint64 maxFrameCounts = frequency / 4;
+
+    // 経過時間を蓄積
+    Uint64 frameCounts = counter - simLastCounter;
+    simLastCounter = counter;
+    if (frameCounts > maxFrameCounts) {
+        frameCounts = maxFrameCounts;
+    }
+    simAccumulator += frameCounts;
+
+    // 蓄積した時間ぶん固定ティックで進め、ティックごとに状態を公開する
+    // 終了したティックで止め、記録の最終ティックを再生と一致させる
+    while (simAccumulator >= tickCounts && !isSessionFinished(sim)) {
+        // このティックが表す実時間の間に起きた入力を、その時刻で適用する
+        Uint64 tickStart = counter - simAccumulator;
+        takeInput(tickStart, tickStart + tickCounts);
+        update(tickMs);
+        simAccumulator -= tickCounts;
+        publishSnapshot(tickStart + tickCounts);
+    }
+}
+
+void Game::publishSnapshot(Uint64 tickCounter) {
+    SimSnapshot& snapshot = snapshots.writeSlot();
+    snapshot.gameState = sim.gameState;
+    snapshot.now = sim.now;
+    snapshot.gameOverTime = sim.gameOverTime;
+    snapshot.score = sim.score;
+    snapshot.currentTime = sim.currentTime;
+    snapshot.currentMaxTime = sim.currentMaxTime;
+    snapshot.round = sim.round;
+    snapshot.playerX = sim.player.getX();
+    snapshot.playerY = sim.player.getY();
+    snapshot.prevPlayerX = prevPlayerX;
+    snapshot.prevPlayerY = prevPlayerY;
+    snapshot.playerMoving = sim.player.isMoving();
+    snapshot.tickCounter = tickCounter;
+    snapshot.updateMicros = updateMicros;
+    snapshot.latency = inputStamp;
+    snapshots.publish();
+}
+
+bool Game::acquireSnapshot() {
+    if (!snapshots.acquire()) {
+        return false;
+    }
+    view = snapshots.readSlot();
+
+    // 新しく受け付けた入力があれば、記録された時刻で遅延の計測を始める
+    // （描画が止まっている間に複数受け付けた場合は最後の1件だけ）
+    const InputLatencyStamp& stamp = view.latency;
+    if (stamp.serial != lastInputSerial) {
+        lastInputSerial = stamp.serial;
+        latencyProbe.beginSample(stamp.eventTimestamp, stamp.pollTicks,
+                                 stamp.pollCounter);
+        latencyProbe.markStage(LATENCY_APPLY, stamp.applyCounter);
+        latencyProbe.markStage(LATENCY_UPDATE, stamp.updateCounter);
+    }
+    return true;
+}
 
-        SDL_RenderPresent(renderer);
-        SDL_Delay(16);  // 60fps相当
+void Game::runReplay() {
+    // 通常時の描画頻度（約60FPS）に合わせ、数ティックごとに1回描画する
+    Uint32 ticksPerFrame = 1000 / 60 / tickMs;
+    if (ticksPerFrame == 0) {
+        ticksPerFrame = 1;
     }
 
-    // "Go!" 表示
-    Uint32 goStartTime = SDL_GetTicks();
-    bool goShown = true;
+    // 取り込むフレームは毎回同じ見た目になるよう、文字が揃ってから始める
+    if (captureConfig.isEnabled()) {
+        finishLoadingAssets();
+        frameCapture.start(captureConfig, WINDOW_WIDTH, WINDOW_HEIGHT);
+    }
 
-    while (goShown) {
-        // イベント処理
+    Uint64 startCounter = SDL_GetPerformanceCounter();
+    Uint32 frames = 0;
+    bool quit = false;
+
+    while (!quit && !isSessionFinished(sim)) {
+        // ウィンドウを閉じる操作だけは受け付ける
         SDL_Event e;
         while (SDL_PollEvent(&e)) {
             if (e.type == SDL_QUIT) {
-                gameState = STATE_GAMEOVER;
-                return;
+                quit = true;
             }
         }
 
-        // 1秒間 "Go!" を表示
-        if (SDL_GetTicks() - goStartTime >= 1000) {
-            goShown = false;
+        // 記録された入力で固定ティックを進める
+        for (Uint32 i = 0; i < ticksPerFrame && !isSessionFinished(sim);
+             i++) {
+            recording.nextInput(tickCount, pendingInput);
+            update(tickMs);
         }
 
-        // 描画
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderClear(renderer);
-
-        // "Go!" 表示
-        int textW, textH;
-        SDL_Texture* goTex = renderText("Go!", GREEN, textW, textH);
-        if (goTex) {
-            SDL_Rect dst = {WINDOW_WIDTH / 2 - textW / 2,
-                            WINDOW_HEIGHT / 2 - textH / 2, textW, textH};
-            SDL_RenderCopy(renderer, goTex, nullptr, &dst);
-            SDL_DestroyTexture(goTex);
-        }
+        pollAssets();
+        publishSnapshot(SDL_GetPerformanceCounter());
+        acquireSnapshot();
+        render(0.0f);
+        markFramePresented();
+        frames++;
+    }
 
-        SDL_RenderPresent(renderer);
-        SDL_Delay(16);
+    double seconds =
+        static_cast<double>(SDL_GetPerformanceCounter() - startCounter) /
+        SDL_GetPerformanceFrequency();
+    SDL_Log("Replay: %u ticks, %u frames in %.3f s (%.1f fps)", tickCount,
+            frames, seconds, seconds > 0 ? frames / seconds : 0.0);
+    frameCapture.stop();
+
+    // 記録時の結果と一致するか確認
+    if (!quit) {
+        bool match = tickCount == recording.getFinalTick() &&
+                     sim.score == recording.getFinalScore();
+        SDL_Log("Replay result: score %d (recorded %d), tick %u (recorded %u) "
+                "%s",
+                sim.score, recording.getFinalScore(), tickCount,
+                recording.getFinalTick(), match ? "MATCH" : "MISMATCH");
     }
+}
 
-    // ゲーム開始
-    gameState = STATE_PLAYING;
+void Game::startBotCapture() {
+    // 人のプレイは毎回違うので取り込まない
+    if (!botEnabled) {
+        SDL_Log("Frame capture needs a replay (--replay) or a bot run (--bot); "
+                "ignoring it");
+        return;
+    }
+
+    // 自動プレイヤーの実行（夜間の長時間実行）では、描画の補間や点滅が
+    // 実時間で決まりフレームが再現しないので、保存とハッシュだけ行う
+    FrameCaptureConfig config = captureConfig;
+    if (!config.goldenDir.empty()) {
+        SDL_Log("Golden images are only compared in replays; saving frames "
+                "only");
+        config.goldenDir.clear();
+    }
+    if (!config.isEnabled()) {
+        return;
+    }
+    finishLoadingAssets();
+    frameCapture.start(config, WINDOW_WIDTH, WINDOW_HEIGHT);
 }
 
-SDL_Color Game::getRandomColor() {
-    int index = rand() % 4;
-    return colorSet[index];
+void Game::initRound() {
+    // スコア・タイマー・色・プレイヤーを初期化
+    resetRound(sim);
+    prevPlayerX = sim.player.getX();
+    prevPlayerY = sim.player.getY();
+    staticLayerValid = false;
+
+    // 点滅状態初期化
+    lastBlinkTime = getBlinkClock();
+    blinkOn = false;
 }
 
-void Game::randomizeWallColors() {
-    wallTopColor = getRandomColor();
-    wallBottomColor = getRandomColor();
-    wallLeftColor = getRandomColor();
-    wallRightColor = getRandomColor();
+void Game::startCountdown() {
+    sim.gameState = STATE_COUNTDOWN;
+    countdownStart = SDL_GetTicks();
+    countdownStep = 0;
+    frameDirty = true;
+    publishSnapshot(SDL_GetPerformanceCounter());
+}
 
-    // 4枚の壁の中から1枚ランダムに選び、必ず directiveColor にする
-    int wallIndex = rand() % 4;
-    switch (wallIndex) {
-        case 0:
-            wallTopColor = directiveColor;
-            break;
-        case 1:
-            wallBottomColor = directiveColor;
-            break;
-        case 2:
-            wallLeftColor = directiveColor;
-            break;
-        case 3:
-            wallRightColor = directiveColor;
-            break;
+void Game::updateCountdown() {
+    // カウントダウン中の入力は捨てる
+    inputQueue.discard();
+
+    // 1段階ずつ表示し、最後の「Go!」を出し終えたらゲーム開始
+    countdownStep =
+        static_cast<int>((SDL_GetTicks() - countdownStart) /
+                         COUNTDOWN_STEP_TIME);
+    if (countdownStep < COUNTDOWN_STEPS) {
+        return;
+    }
+    countdownStep = 0;
+
+    // 点滅はゲーム開始から数える
+    lastBlinkTime = getBlinkClock();
+
+    // 開始時の状態を公開してから、シミュレーションスレッドに渡す
+    sim.gameState = STATE_PLAYING;
+    publishSnapshot(SDL_GetPerformanceCounter());
+    if (!startSimulation()) {
+        SDL_Log("Running the simulation on the main thread");
     }
 }
 
 void Game::handleEvents() {
+    PROFILE_ZONE("Game::handleEvents");
     SDL_Event e;
     while (SDL_PollEvent(&e)) {
         // 終了イベント
         if (e.type == SDL_QUIT) {
-            gameState = STATE_GAMEOVER;
-            gameOverTime = SDL_GetTicks();
+            quitRequested.store(true);
+            windowClosed = true;
         }
 
-        // キー入力（プレイ中のみ処理）
-        if (gameState == STATE_PLAYING && e.type == SDL_KEYDOWN) {
-            // プレイヤーが移動中でない場合のみ入力を受け付ける
-            if (!player.isMoving()) {
-                Direction inputDir = DIR_NONE;
-
-                switch (e.key.keysym.sym) {
-                    case SDLK_w:
-                    case SDLK_UP:
-                        inputDir = DIR_UP;
-                        break;
-                    case SDLK_s:
-                    case SDLK_DOWN:
-                        inputDir = DIR_DOWN;
-                        break;
-                    case SDLK_a:
-                    case SDLK_LEFT:
-                        inputDir = DIR_LEFT;
-                        break;
-                    case SDLK_d:
-                    case SDLK_RIGHT:
-                        inputDir = DIR_RIGHT;
-                        break;
-                }
-
-                // 有効な入力があれば移動処理を開始
-                if (inputDir != DIR_NONE) {
-                    player.setMovementTarget(inputDir);
-                    gameState = STATE_MOVING;
-                }
+        // レンダーターゲットの内容が失われたら静的レイヤーを描き直す
+        // デバイスのリセットではテクスチャ自体が無効になるので作り直す
+        if (e.type == SDL_RENDER_TARGETS_RESET ||
+            e.type == SDL_RENDER_DEVICE_RESET) {
+            if (e.type == SDL_RENDER_DEVICE_RESET) {
+                backend->resetLayer();
             }
+            staticLayerValid = false;
+            frameDirty = true;
+        }
+
+        // 読み込みスレッドからの完了通知（pollAssets で受け取る）
+        if (assetEventType != 0 && e.type == assetEventType) {
+            frameDirty = true;
+        }
+
+        // ウィンドウの再表示・サイズ変更などでは描き直す
+        if (e.type == SDL_WINDOWEVENT) {
+            frameDirty = true;
+        }
+
+        // F1：入力遅延オーバーレイの表示切り替え
+        if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F1) {
+            showLatencyOverlay = !showLatencyOverlay;
         }
+
+        // F2：区間計測のトレースを書き出す
+        if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F2) {
+            writeTrace();
+        }
+
+        // 移動のキー入力は captureInput で取り込み済み
     }
 }
 
-void Game::update(float deltaTime) {
-    Uint32 currentTicks = SDL_GetTicks();
+int Game::captureInput(void* userdata, SDL_Event* event) {
+    // イベントがSDLのキューに入るときに呼ばれる（イベントを取り込む
+    // スレッド上）。ここでは時刻を付けて入力キューに積むだけにする
+    if (event->type != SDL_KEYDOWN) {
+        return 0;
+    }
+    Direction dir = DIR_NONE;
+    switch (event->key.keysym.sym) {
+        case SDLK_w:
+        case SDLK_UP:
+            dir = DIR_UP;
+            break;
+        case SDLK_s:
+        case SDLK_DOWN:
+            dir = DIR_DOWN;
+            break;
+        case SDLK_a:
+        case SDLK_LEFT:
+            dir = DIR_LEFT;
+            break;
+        case SDLK_d:
+        case SDLK_RIGHT:
+            dir = DIR_RIGHT;
+            break;
+    }
+    if (dir == DIR_NONE) {
+        return 0;
+    }
 
-    // プレイ中またはアニメーション中はタイマー更新
-    if (gameState == STATE_PLAYING || gameState == STATE_MOVING) {
-        currentTime -= deltaTime;
+    InputEvent input;
+    input.dir = dir;
+    input.timestamp = event->key.timestamp;
+    input.counter = SDL_GetPerformanceCounter();
+    Game* game = static_cast<Game*>(userdata);
+    if (!game->inputQueue.push(input)) {
+        SDL_Log("Input queue full; dropping key input");
+    }
+    return 0;
+}
 
-        // タイムアップ判定
-        if (currentTime <= 0) {
-            currentTime = 0;
-            gameState = STATE_GAMEOVER;
-            gameOverTime = currentTicks;
-        }
+void Game::takeInput(Uint64 tickStart, Uint64 tickEnd) {
+    // 終了要求はこのティックで適用する
+    if (quitRequested.exchange(false)) {
+        pendingInput.quit = true;
     }
 
-    // アニメーション中の更新処理
-    if (gameState == STATE_MOVING) {
-        // プレイヤーの位置更新
-        player.update(currentTicks);
-
-        // 移動完了判定
-        if (player.isMovementComplete(currentTicks)) {
-            // 衝突判定：正しい壁に接触したか
-            if (player.checkCollision(player.getMoveDir(), wallTopColor,
-                                      wallBottomColor, wallLeftColor,
-                                      wallRightColor, directiveColor)) {
-                // 成功
-                score++;
-                successCount++;
-
-                // 5回成功するたびにタイマー制限を厳しくする
-                if (successCount % 5 == 0) {
-                    currentMaxTime -= 0.2f;
-                    if (currentMaxTime < MIN_MAX_TIME) {
-                        currentMaxTime = MIN_MAX_TIME;
-                    }
-                }
-
-                // 次ラウンドの準備
-                player.reset();
-                currentTime = currentMaxTime;
-                directiveColor = getRandomColor();
-                randomizeWallColors();
-                gameState = STATE_PLAYING;
-            } else {
-                // 失敗（ゲームオーバー）
-                gameState = STATE_GAMEOVER;
-                gameOverTime = currentTicks;
-            }
+    // 自動プレイヤーはキー入力と同じ経路（このティックの入力）で操作する
+    if (botEnabled) {
+        takeBotInput();
+        return;
+    }
+
+    // tickEnd より前に起きた入力を取り出す（後の入力は次のティック以降）
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    InputEvent input;
+    while (inputQueue.peek(input) && input.counter < tickEnd) {
+        inputQueue.pop();
+
+        // プレイ中（移動中でない）かつ、まだ入力が無い場合のみ受け付ける
+        if (sim.gameState != STATE_PLAYING || pendingInput.dir != DIR_NONE) {
+            continue;
+        }
+        pendingInput.dir = input.dir;
+        // ティックの途中の時刻（以前のティックの入力は先頭に寄せる）
+        pendingInput.offsetMs =
+            input.counter > tickStart
+                ? static_cast<Uint32>((input.counter - tickStart) * 1000 /
+                                      frequency)
+                : 0;
+        if (pendingInput.offsetMs >= tickMs) {
+            pendingInput.offsetMs = tickMs - 1;
         }
+
+        // 遅延の計測は描画側でスナップショットから始める
+        inputStamp.eventTimestamp = input.timestamp;
+        inputStamp.pollTicks = SDL_GetTicks();
+        inputStamp.pollCounter = SDL_GetPerformanceCounter();
+        inputStampPending = true;
     }
 }
 
-void Game::render() {
-    // 背景をクリア
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderClear(renderer);
+void Game::takeBotInput() {
+    // 人のキー入力は使わない
+    inputQueue.discard();
 
-    // 壁の描画
-    // 上壁
-    SDL_SetRenderDrawColor(renderer, wallTopColor.r, wallTopColor.g,
-                           wallTopColor.b, wallTopColor.a);
-    SDL_RenderFillRect(renderer, &topWall);
-    // 下壁
-    SDL_SetRenderDrawColor(renderer, wallBottomColor.r, wallBottomColor.g,
-                           wallBottomColor.b, wallBottomColor.a);
-    SDL_RenderFillRect(renderer, &bottomWall);
-    // 左壁
-    SDL_SetRenderDrawColor(renderer, wallLeftColor.r, wallLeftColor.g,
-                           wallLeftColor.b, wallLeftColor.a);
-    SDL_RenderFillRect(renderer, &leftWall);
-    // 右壁
-    SDL_SetRenderDrawColor(renderer, wallRightColor.r, wallRightColor.g,
-                           wallRightColor.b, wallRightColor.a);
-    SDL_RenderFillRect(renderer, &rightWall);
+    SimInput input = bot.think(sim);
+    if (input.dir == DIR_NONE || sim.gameState != STATE_PLAYING ||
+        pendingInput.dir != DIR_NONE) {
+        return;
+    }
+    pendingInput.dir = input.dir;
+    pendingInput.offsetMs = 0;
+
+    // 入力遅延の計測もキー入力と同じく行う（発生時刻 = 決めた時刻）
+    inputStamp.eventTimestamp = SDL_GetTicks();
+    inputStamp.pollTicks = inputStamp.eventTimestamp;
+    inputStamp.pollCounter = SDL_GetPerformanceCounter();
+    inputStampPending = true;
+}
+
+void Game::update(Uint32 deltaMs) {
+    PROFILE_ZONE("Game::update");
+
+    // 補間用に更新前の位置を保存
+    prevPlayerX = sim.player.getX();
+    prevPlayerY = sim.player.getY();
+
+    // ルールの更新はすべてシミュレーション側で行う
+    bool applyingInput = inputStampPending &&
+                         pendingInput.dir != DIR_NONE &&
+                         sim.gameState == STATE_PLAYING;
+    if (applyingInput) {
+        inputStamp.applyCounter = SDL_GetPerformanceCounter();
+    }
+    // 自動プレイヤーの入力は --record の指定があるときだけ記録する
+    // （長時間実行で記録が伸び続けないように）
+    if (!replayMode && (!botEnabled || !recordPath.empty())) {
+        recording.addInput(tickCount, pendingInput);
+    }
+    Uint64 stepStart = SDL_GetPerformanceCounter();
+    stepSimulation(sim, pendingInput, deltaMs);
+    updateMicros = static_cast<Uint32>(
+        (SDL_GetPerformanceCounter() - stepStart) * 1000000 /
+        SDL_GetPerformanceFrequency());
+    tickCount++;
+    if (applyingInput) {
+        inputStamp.updateCounter = SDL_GetPerformanceCounter();
+        inputStamp.serial++;
+    }
+    inputStampPending = false;
+    pendingInput = SimInput();
+}
+
+void Game::render(float alpha) {
+    PROFILE_ZONE("Game::render");
+
+    if (view.gameState == STATE_COUNTDOWN) {
+        queueCountdown();
+    } else {
+        queueGameScene(alpha);
+    }
+
+    // 入力遅延オーバーレイ
+    if (showLatencyOverlay) {
+        renderLatencyOverlay();
+    }
+
+    // 溜めた描画をレイヤー・テクスチャ順にまとめて送る
+    {
+        PROFILE_ZONE("RenderQueue::flush");
+        renderQueue.flush(*backend);
+    }
+
+    // 回帰テストのフレームの取り込み（画面に出す前のバックバッファから）
+    if (frameCapture.isRunning()) {
+        captureFrame();
+    }
+
+    // 移動中のプレイヤーを含む最初のフレームで遅延を記録
+    bool latencyFrame = view.playerMoving &&
+                        latencyProbe.isWaitingFor(LATENCY_SUBMIT);
+    if (latencyFrame) {
+        latencyProbe.markStage(LATENCY_SUBMIT);
+    }
+
+    // バックバッファを画面に反映
+    {
+        PROFILE_ZONE("RenderBackend::present");
+        backend->present();
+    }
+
+    if (latencyFrame) {
+        latencyProbe.markStage(LATENCY_PRESENT);
+    }
+}
+
+void Game::queueGameScene(float alpha) {
+    // 壁・指示枠・スコアなど、ラウンド中に変わらない部分
+    // 色かスコアが変わったときだけ作り直し、それ以外は1回のコピーで済ませる
+    bool staticLayerStale = !staticLayerValid ||
+                            staticLayerRound != view.round ||
+                            staticLayerScore != view.score;
+    if (staticLayerStale) {
+        updateStaticLayer();
+    }
+    if (staticLayerValid) {
+        backend->drawLayer();
+    } else {
+        // レイヤーが使えない場合は毎フレーム描き直す
+        backend->clear(BLACK);
+        queueStaticLayer();
+    }
 
+    // 以下は毎フレーム変わる部分
     // タイマーゲージの描画
-    int gaugeCurrentWidth = (int)(GAUGE_WIDTH * (currentTime / currentMaxTime));
+    int gaugeCurrentWidth = getGaugeWidth();
     SDL_Rect currentGauge = {gaugeRect.x, gaugeRect.y, gaugeCurrentWidth,
                              gaugeRect.h};
 
-    // 背景を黒色に
-    SDL_SetRenderDrawColor(renderer, BLACK.r, BLACK.g, BLACK.b, BLACK.a);
-    SDL_RenderFillRect(renderer, &gaugeRect);
-
     // ゲージの描画（残り時間に応じて色と点滅を制御）
-    if (gaugeCurrentWidth <= GAUGE_WIDTH / 2) {
-        Uint32 currentTicks = SDL_GetTicks();
-        if (currentTicks - lastBlinkTime > BLINK_INTERVAL) {
-            blinkOn = !blinkOn;
-            lastBlinkTime = currentTicks;
-        }
+    updateBlink();
+    SDL_Color gaugeColor = GREEN;
+    if (gaugeCurrentWidth <= GAUGE_WIDTH / 2 && blinkOn) {
+        gaugeColor = RED;
+    }
+    renderQueue.addRect(currentGauge, gaugeColor, LAYER_HUD);
 
-        if (blinkOn) {
-            SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);  // 赤
-        } else {
-            SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);  // 緑
-        }
+    // ゲージの枠（ゲージの端に重なるのでゲージの後に描く）
+    renderQueue.addRectOutline(gaugeRect, WHITE, LAYER_HUD);
+
+    // プレイヤーの描画
+    float playerX = view.playerX;
+    float playerY = view.playerY;
+    if (view.playerMoving) {
+        // 移動中は前ティックとの間を補間する
+        // （中央へ戻った直後は補間すると軌跡が出るので行わない）
+        playerX = view.prevPlayerX + (playerX - view.prevPlayerX) * alpha;
+        playerY = view.prevPlayerY + (playerY - view.prevPlayerY) * alpha;
+    }
+    renderPlayer(renderQueue, playerX, playerY, &playerSprite);
+
+    // ゲームオーバー表示
+    if (view.gameState == STATE_GAMEOVER) {
+        renderText("GAME OVER", RED, WINDOW_WIDTH / 2, WINDOW_HEIGHT / 2);
+
+        // スコアの表示（上端を画面中央+50pxに揃える）
+        updateScoreText();
+        renderText(finalScoreText, WHITE, WINDOW_WIDTH / 2,
+                   WINDOW_HEIGHT / 2 + 50 + textRenderer.getLineHeight() / 2);
+    }
+}
+
+void Game::queueCountdown() {
+    // 黒い画面の中央に現在のラベルだけを描く
+    backend->clear(BLACK);
+
+    int step = countdownStep < COUNTDOWN_STEPS ? countdownStep
+                                               : COUNTDOWN_STEPS - 1;
+    SDL_Color color = step == COUNTDOWN_STEPS - 1 ? GREEN : WHITE;
+    if (countdownLabels.isReady()) {
+        countdownLabels.drawCentered(renderQueue, step, color,
+                                     WINDOW_WIDTH / 2, WINDOW_HEIGHT / 2,
+                                     LAYER_TEXT);
     } else {
-        SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);  // 緑
+        // 大きいサイズを作れなかった場合は通常の文字で表示
+        renderText(COUNTDOWN_LABELS[step], color, WINDOW_WIDTH / 2,
+                   WINDOW_HEIGHT / 2);
     }
+}
 
-    SDL_RenderFillRect(renderer, &currentGauge);
+void Game::updateBlink() {
+    // 残り時間が半分以下の間、ゲージを一定間隔で点滅させる
+    if (getGaugeWidth() > GAUGE_WIDTH / 2) {
+        return;
+    }
+    Uint32 currentTicks = getBlinkClock();
+    if (currentTicks - lastBlinkTime > BLINK_INTERVAL) {
+        blinkOn = !blinkOn;
+        lastBlinkTime = currentTicks;
+    }
+}
 
-    // ゲージの枠
-    SDL_SetRenderDrawColor(renderer, WHITE.r, WHITE.g, WHITE.b, WHITE.a);
-    SDL_RenderDrawRect(renderer, &gaugeRect);
+Uint32 Game::getBlinkClock() const {
+    // 再生では取り込むフレームが毎回同じになるようゲーム内の時刻で点滅させる
+    return replayMode ? view.now : SDL_GetTicks();
+}
 
-    // 指示枠の描画（右上）
-    SDL_SetRenderDrawColor(renderer, directiveColor.r, directiveColor.g,
-                           directiveColor.b, directiveColor.a);
-    SDL_RenderFillRect(renderer, &directiveRect);
-    SDL_SetRenderDrawColor(renderer, WHITE.r, WHITE.g, WHITE.b, WHITE.a);
-    SDL_RenderDrawRect(renderer, &directiveRect);
+void Game::captureFrame() {
+    PROFILE_ZONE("Game::captureFrame");
+    // 空きバッファへ読み出すだけで、保存や比較は作業スレッドが行う
+    // ティック番号はスナップショットの時刻から求める（tickCount は
+    // シミュレーションスレッドのもの。時刻はセッションをまたいで増え続ける）
+    Uint32* pixels = frameCapture.beginFrame(view.now / tickMs);
+    if (!pixels) {
+        return;
+    }
+    if (backend->readPixels(pixels, WINDOW_WIDTH, WINDOW_HEIGHT)) {
+        frameCapture.submitFrame();
+    } else {
+        SDL_Log("Failed to read back the frame: %s", SDL_GetError());
+        frameCapture.cancelFrame();
+    }
+}
 
-    // スコア表示
-    std::stringstream ss;
-    ss << "Score: " << score;
-    int textW, textH;
-    SDL_Texture* scoreTex = renderText(ss.str(), WHITE, textW, textH);
-    if (scoreTex) {
-        SDL_Rect dst = {SCORE_POS_X - textW / 2, SCORE_POS_Y - textH / 2, textW,
-                        textH};
-        SDL_RenderCopy(renderer, scoreTex, nullptr, &dst);
-        SDL_DestroyTexture(scoreTex);
+int Game::getGaugeWidth() const {
+    return GAUGE_WIDTH * view.currentTime / view.currentMaxTime;
+}
+
+Game::FrameSignature Game::getFrameSignature() const {
+    FrameSignature frame;
+    frame.gameState = view.gameState;
+    frame.countdownStep = countdownStep;
+    frame.round = view.round;
+    frame.score = view.score;
+    frame.gaugeWidth = getGaugeWidth();
+    // 点滅はゲージが見えていて半分以下のときだけ見た目に出る
+    frame.blinkOn = blinkOn && frame.gaugeWidth > 0 &&
+                    frame.gaugeWidth <= GAUGE_WIDTH / 2;
+    frame.playerX = view.playerX;
+    frame.playerY = view.playerY;
+    frame.overlay = showLatencyOverlay;
+    frame.latencySamples = latencyProbe.getSampleCount();
+    frame.statsWindow = showLatencyOverlay ? pacingStats.getWindowIndex() : 0;
+    return frame;
+}
+
+bool Game::needsRedraw() const {
+    // 移動中は補間位置が毎回変わる
+    if (frameDirty || view.playerMoving) {
+        return true;
     }
+    FrameSignature frame = getFrameSignature();
+    return frame.gameState != lastFrame.gameState ||
+           frame.countdownStep != lastFrame.countdownStep ||
+           frame.round != lastFrame.round || frame.score != lastFrame.score ||
+           frame.gaugeWidth != lastFrame.gaugeWidth ||
+           frame.blinkOn != lastFrame.blinkOn ||
+           frame.playerX != lastFrame.playerX ||
+           frame.playerY != lastFrame.playerY ||
+           frame.overlay != lastFrame.overlay ||
+           frame.latencySamples != lastFrame.latencySamples ||
+           frame.statsWindow != lastFrame.statsWindow;
+}
 
-    // プレイヤーの描画
-    player.render(renderer);
+Uint32 Game::getIdleWait(Uint32 accumulatedMs) const {
+    // 受け付けた入力は次のティックで適用する
+    if (quitRequested.load() || !inputQueue.empty()) {
+        return accumulatedMs < tickMs ? tickMs - accumulatedMs : 1;
+    }
 
-    // ゲームオーバー表示
-    if (gameState == STATE_GAMEOVER) {
-        int textW, textH;
-        SDL_Texture* goTex = renderText("GAME OVER", RED, textW, textH);
-        if (goTex) {
-            SDL_Rect dst = {WINDOW_WIDTH / 2 - textW / 2,
-                            WINDOW_HEIGHT / 2 - textH / 2, textW, textH};
-            SDL_RenderCopy(renderer, goTex, nullptr, &dst);
-            SDL_DestroyTexture(goTex);
-        }
+    // カウントダウン中は次のラベルに切り替わるまで
+    if (view.gameState == STATE_COUNTDOWN) {
+        Uint32 elapsed = SDL_GetTicks() - countdownStart;
+        Uint32 untilStep = COUNTDOWN_STEP_TIME - elapsed % COUNTDOWN_STEP_TIME;
+        return untilStep < MAX_IDLE_WAIT ? untilStep : MAX_IDLE_WAIT;
+    }
 
-        // スコアの表示
-        std::stringstream ss;
-        ss << "Final Score: " << score;
-        SDL_Texture* finalScoreTex = renderText(ss.str(), WHITE, textW, textH);
-        if (finalScoreTex) {
-            SDL_Rect dst = {WINDOW_WIDTH / 2 - textW / 2,
-                            WINDOW_HEIGHT / 2 + 50, textW, textH};
-            SDL_RenderCopy(renderer, finalScoreTex, nullptr, &dst);
-            SDL_DestroyTexture(finalScoreTex);
+    // アニメーション中は描画間隔ごと（VSyncがあれば描画自体が待つ）
+    if (view.playerMoving) {
+        return vsyncEnabled ? 0 : ANIMATION_FRAME_INTERVAL;
+    }
+
+    // 次に見た目が変わるまでのゲーム内の時間（ミリ秒）
+    Uint32 untilChange = MAX_IDLE_WAIT;
+    if (view.gameState == STATE_PLAYING) {
+        // ゲージが1ピクセル縮む時刻（幅0になった後は時間切れの時刻）
+        int width = getGaugeWidth();
+        int untilGauge = view.currentTime;
+        if (width > 0) {
+            int threshold = (width * view.currentMaxTime - 1) / GAUGE_WIDTH;
+            untilGauge = view.currentTime - threshold;
+        }
+        if (untilGauge < static_cast<int>(untilChange)) {
+            untilChange = untilGauge > 0 ? untilGauge : 0;
+        }
+    } else if (view.gameState == STATE_GAMEOVER) {
+        // ゲームオーバー表示の終了
+        Uint32 shown = view.now - view.gameOverTime;
+        Uint32 untilEnd =
+            shown < GAMEOVER_HOLD_TIME ? GAMEOVER_HOLD_TIME - shown : 0;
+        if (untilEnd < untilChange) {
+            untilChange = untilEnd;
+        }
+    }
+    // ゲーム内の時間は蓄積済みの分だけ先に進む
+    Uint32 wait = untilChange > accumulatedMs ? untilChange - accumulatedMs : 0;
+
+    // 点滅の切り替え（実時間）
+    int gaugeWidth = getGaugeWidth();
+    if (gaugeWidth > 0 && gaugeWidth <= GAUGE_WIDTH / 2) {
+        Uint32 sinceBlink = getBlinkClock() - lastBlinkTime;
+        Uint32 untilBlink =
+            sinceBlink <= BLINK_INTERVAL ? BLINK_INTERVAL + 1 - sinceBlink : 0;
+        if (untilBlink < wait) {
+            wait = untilBlink;
         }
     }
+    return wait;
+}
 
-    // バックバッファを画面に反映
-    SDL_RenderPresent(renderer);
+void Game::queueStaticLayer() {
+    // 壁の描画
+    renderQueue.addRect(topWall, colorSet[roundWall(view.round, WALL_TOP)],
+                        LAYER_WORLD);
+    renderQueue.addRect(bottomWall,
+                        colorSet[roundWall(view.round, WALL_BOTTOM)],
+                        LAYER_WORLD);
+    renderQueue.addRect(leftWall, colorSet[roundWall(view.round, WALL_LEFT)],
+                        LAYER_WORLD);
+    renderQueue.addRect(rightWall, colorSet[roundWall(view.round, WALL_RIGHT)],
+                        LAYER_WORLD);
+
+    // タイマーゲージの背景
+    renderQueue.addRect(gaugeRect, BLACK, LAYER_HUD);
+
+    // 指示枠の描画（右上）
+    renderQueue.addRect(directiveRect, colorSet[roundDirective(view.round)],
+                        LAYER_HUD);
+    renderQueue.addRectOutline(directiveRect, WHITE, LAYER_HUD);
+
+    // スコア表示
+    updateScoreText();
+    renderText(scoreText, WHITE, SCORE_POS_X, SCORE_POS_Y);
 }
 
-SDL_Texture* Game::renderText(const std::string& message, SDL_Color color,
-                              int& textW, int& textH) {
-    if (!font) {
-        return nullptr;
+void Game::updateScoreText() {
+    // スコアが変わったときだけ整形し、以降のフレームは同じ文字列を使う
+    if (view.score == formattedScore) {
+        return;
     }
+    formattedScore = view.score;
+    snprintf(scoreText, sizeof(scoreText), "Score: %d", formattedScore);
+    snprintf(finalScoreText, sizeof(finalScoreText), "Final Score: %d",
+             formattedScore);
+}
 
-    SDL_Surface* surface = TTF_RenderText_Blended(font, message.c_str(), color);
-    if (!surface) {
-        SDL_Log("TTF_RenderText_Blended Error: %s", TTF_GetError());
-        return nullptr;
-    }
+void Game::updateStaticLayer() {
+    PROFILE_ZONE("Game::updateStaticLayer");
+
+    staticLayerRound = view.round;
+    staticLayerScore = view.score;
+    staticLayerValid = false;
 
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (!texture) {
-        SDL_Log("SDL_CreateTextureFromSurface Error: %s", SDL_GetError());
-        SDL_FreeSurface(surface);
-        return nullptr;
+    if (!backend->beginLayer()) {
+        return;
     }
 
-    textW = surface->w;
-    textH = surface->h;
+    // render の先頭（キューが空のとき）に呼ぶので、静的な部分だけが流れる
+    backend->clear(BLACK);
+    queueStaticLayer();
+    renderQueue.flush(*backend);
+    backend->endLayer();
+    staticLayerValid = true;
+}
+
+void Game::renderText(const char* message, SDL_Color color, int centerX,
+                      int centerY) {
+    PROFILE_ZONE("Game::renderText");
 
-    SDL_FreeSurface(surface);
-    return texture;
+    // 初期化時に焼き込んだアトラスから描画する（毎フレームの
+    // ラスタライズやテクスチャ生成は行わない）
+    textRenderer.drawTextCentered(renderQueue, message, color, centerX,
+                                  centerY);
 }
 
-void Game::drawFilledCircle(int centerX, int centerY, int radius) {
-    // 円を塗りつぶして描画
-    // 各ピクセルについて中心からの距離を計算し、半径以内ならば描画
-    for (int w = 0; w < radius * 2; w++) {
-        for (int h = 0; h < radius * 2; h++) {
-            int dx = radius - w;
-            int dy = radius - h;
-            if ((dx * dx + dy * dy) <= (radius * radius)) {
-                SDL_RenderDrawPoint(renderer, centerX + dx - radius,
-                                    centerY + dy - radius);
-            }
+void Game::renderLatencyOverlay() {
+    // 入力イベントから各段階までの遅延（直近の p50/p95/p99）
+    int lineHeight = textRenderer.getLineHeight();
+    int x = WALL_THICKNESS + 10;
+    int y = gaugeRect.y + gaugeRect.h + 20;
+    char line[96];
+
+    snprintf(line, sizeof(line), "latency (n=%d)",
+             latencyProbe.getSampleCount());
+    textRenderer.drawText(renderQueue, line, WHITE, x, y);
+
+    for (int s = 0; s < LATENCY_STAGE_COUNT; s++) {
+        LatencyStage stage = static_cast<LatencyStage>(s);
+        float p50, p95, p99;
+        latencyProbe.getPercentiles(stage, p50, p95, p99);
+        snprintf(line, sizeof(line), "%-7s %6.1f %6.1f %6.1f ms",
+                 getStageName(stage), p50, p95, p99);
+        y += lineHeight;
+        textRenderer.drawText(renderQueue, line, WHITE, x, y);
+    }
+
+    // 直近1秒間のループの起床回数と描画回数
+    snprintf(line, sizeof(line), "wakeups %d/s  frames %d/s",
+             pacingStats.getWakeupsPerSecond(),
+             pacingStats.getFramesPerSecond());
+    y += lineHeight;
+    textRenderer.drawText(renderQueue, line, WHITE, x, y);
+
+    // メモリ使用量（毎秒の標本。括弧内は最大値）
+    const double MB = 1024.0 * 1024.0;
+    const MemorySample& memory = memoryTelemetry.getCurrent();
+    const MemorySample& peak = memoryTelemetry.getPeak();
+    snprintf(line, sizeof(line), "textures %d  %.2f MB (%.2f)",
+             memory.textureCount, memory.textureBytes / MB,
+             peak.textureBytes / MB);
+    y += lineHeight;
+    textRenderer.drawText(renderQueue, line, WHITE, x, y);
+    snprintf(line, sizeof(line), "heap %.1f MB (%.1f)  rss %.1f MB (%.1f)",
+             memory.heapBytes / MB, peak.heapBytes / MB,
+             memory.residentBytes / MB, peak.residentBytes / MB);
+    y += lineHeight;
+    textRenderer.drawText(renderQueue, line, WHITE, x, y);
+}
+
+void Game::publishMetrics(bool rendered, Uint64 renderStart,
+                          Uint64 renderEnd, bool sampled) {
+    MetricsData* data = metricsPublisher.beginUpdate();
+    if (!data) {
+        return;
+    }
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    data->loops++;
+    if (rendered) {
+        if (data->frames > 0) {
+            data->frameIntervalUs = static_cast<uint32_t>(
+                (renderStart - metricsFrameCounter) * 1000000 / frequency);
         }
+        metricsFrameCounter = renderStart;
+        data->renderUs = static_cast<uint32_t>(
+            (renderEnd - renderStart) * 1000000 / frequency);
+        data->frames++;
+    }
+    data->updateUs = view.updateMicros;
+    data->score = view.score;
+    data->gameState = view.gameState;
+    data->simTime = view.now;
+    data->allocations = getAllocationCount();
+    data->texturesCreated = getTexturesCreated();
+
+    // 1秒ごとに変わる値は標本を取ったときだけ書く
+    if (sampled) {
+        float p50, p95, p99;
+        latencyProbe.getPercentiles(LATENCY_PRESENT, p50, p95, p99);
+        data->latencyP50Ms = p50;
+        data->latencyP95Ms = p95;
+        data->latencyP99Ms = p99;
+        data->latencySamples = latencyProbe.getSampleCount();
+        data->framesPerSecond = pacingStats.getFramesPerSecond();
+        const MemorySample& memory = memoryTelemetry.getCurrent();
+        data->textureBytes = memory.textureBytes;
+        data->heapBytes = memory.heapBytes;
+        data->residentBytes = memory.residentBytes;
     }
-}
\ No newline at end of file
+    metricsPublisher.endUpdate();
+}
+
+void Game::writeTrace() {
+    if (!PROFILE_ZONES_ENABLED) {
+        SDL_Log("Profiling zones are not compiled in (use make profile)");
+        return;
+    }
+    const char* path =
+        tracePath.empty() ? DEFAULT_TRACE_PATH : tracePath.c_str();
+    if (PROFILE_WRITE_TRACE(path)) {
+        SDL_Log("Wrote trace: %s", path);
+    } else {
+        SDL_Log("Failed to write trace: %s", path);
+    }
+}
@@ -2,10 +2,30 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 
+#include <atomic>
 #include <string>
 
+#include "AssetLoader.h"
 #include "Constants.h"
-#include "Player.h"
+#include "FrameCapture.h"
+#include "FramePacingStats.h"
+#include "InputQueue.h"
+#include "LabelSprites.h"
+#include "LatencyProbe.h"
+#include "MemoryTelemetry.h"
+#include "MetricsPublisher.h"
+#include "Primitives.h"
+#include "RenderBackend.h"
+#include "RenderQueue.h"
+#include "SimSnapshot.h"
+#include "SoakStats.h"
+#include "SoftwareRasterizer.h"
+#include "StartupProfile.h"
+#include "TextRenderer.h"
+#include "TripleBuffer.h"
+#include "core/BotPlayer.h"
+#include "core/InputRecording.h"
+#include "core/Simulation.h"
 
 class Game {
    public:
@@ -15,43 +35,267 @@ class Game {
     bool initialize();
     void runGame();
 
+    // シミュレーションのティックレート（Hz）を設定する
+    void setTickRate(int ticksPerSecond);
+
+    // 乱数シードを設定する（記録・再生のためにシードを保持する）
+    void setRandomSeed(Uint32 seed);
+
+    // 受け付けた入力を記録し、終了時に path へ保存する
+    void setRecordPath(const std::string& path) { recordPath = path; }
+
+    // 記録ファイルを読み込み、人の入力なしで最大速度で再生するモードにする
+    bool loadReplay(const std::string& path);
+
+    // 入力遅延の計測結果の表示・出力先
+    void setLatencyOverlay(bool enabled) { showLatencyOverlay = enabled; }
+    void setLatencyCsvPath(const std::string& path) { latencyCsvPath = path; }
+
+    // 区間計測のトレース（Chrome trace_event 形式）の出力先
+    // 指定があれば終了時にも書き出す（make profile のビルドのみ）
+    void setTracePath(const std::string& path) { tracePath = path; }
+
+    // 監視ツール（tools/metrics.cpp）向けのメトリクスを name の POSIX 共有
+    // メモリに公開する（空なら公開しない）
+    void setMetricsName(const std::string& name) { metricsName = name; }
+
+    // 再生中に描画したフレームを取り込み、保存・正解画像との比較を行う
+    // 自動プレイヤーの実行（--bot）では保存とハッシュだけ行う
+    void setFrameCapture(const FrameCaptureConfig& config) {
+        captureConfig = config;
+    }
+    // 取り込んだフレームがすべて正解画像と一致したか
+    bool passedFrameCapture() const { return frameCapture.passed(); }
+
+    // ダミーのビデオドライバとソフトウェアレンダラーで、画面を持たずに動かす
+    // （initialize より前に呼ぶ）
+    void setHeadless(bool enabled) { headless = enabled; }
+
+    // SDL_Renderer の代わりに CPU のフレームバッファへ描画する
+    // （initialize より前に呼ぶ）
+    void setSoftwareRaster(bool enabled) { softwareRaster = enabled; }
+
+    // キー入力の代わりに自動プレイヤーが操作する。VSync と待ちを切って
+    // 最大速度で描画し、FPS・フレーム時間・メモリの増え方を報告する
+    // （initialize より前に呼ぶ）
+    void setBot(const BotConfig& config);
+
+    // 自動プレイヤーでセッションを繰り返す時間（分）。0 なら1セッション
+    void setSoakMinutes(int minutes);
+
+    // 画面に変化が無い間はイベント待ちで眠る（false なら毎ループ描画）
+    void setIdleWait(bool enabled) { idleWait = enabled; }
+
+    // 使用するフォントファイル（指定が無ければ既定のフォントを探す）
+    // パスを含まない名前なら探索ディレクトリから探す
+    void setFontPath(const std::string& path) { fontPath = path; }
+
+    // アセットを探すディレクトリを追加する（既定のディレクトリより優先）
+    void addAssetSearchPath(const std::string& dir) {
+        assetLoader.addSearchPath(dir);
+    }
+
+    // 読み込み中のアセットを待って反映する（ツールなどメインループ外で使う）
+    // 戻り値は文字が描画できるか
+    bool finishLoadingAssets();
+
    private:
+    // ベンチマーク（tools/bench.cpp）から更新・描画処理を直接呼ぶ
+    friend class GameBench;
+
+    void startAssetLoading();
+    void loadFont();
+    void pollAssets();
+    void markFramePresented();
     void initRound();
-    void runCountdown();
+    void startCountdown();
+    void updateCountdown();
+    void runReplay();
+    void startBotCapture();
+    void restartSession();
+    bool startSimulation();
+    void stopSimulation();
+    static int simulationThreadMain(void* data);
+    void runSimulation();
+    void advanceSimulation(Uint64 counter);
+    void publishSnapshot(Uint64 tickCounter);
+    bool acquireSnapshot();
     void handleEvents();
-    void update(float deltaTime);
-    void render();
-    SDL_Texture* renderText(const std::string& message, SDL_Color color,
-                            int& textW, int& textH);
-    void drawFilledCircle(int centerX, int centerY, int radius);
-    SDL_Color getRandomColor();
-    void randomizeWallColors();
+    static int SDLCALL captureInput(void* userdata, SDL_Event* event);
+    void takeInput(Uint64 tickStart, Uint64 tickEnd);
+    void takeBotInput();
+    void update(Uint32 deltaMs);
+    void render(float alpha);
+    void queueGameScene(float alpha);
+    void queueCountdown();
+    void updateBlink();
+    Uint32 getBlinkClock() const;
+    void captureFrame();
+    int getGaugeWidth() const;
+    bool needsRedraw() const;
+    Uint32 getIdleWait(Uint32 accumulatedMs) const;
+    void queueStaticLayer();
+    void updateStaticLayer();
+    void updateScoreText();
+    void renderText(const char* message, SDL_Color color, int centerX,
+                    int centerY);
+    void renderLatencyOverlay();
+    void publishMetrics(bool rendered, Uint64 renderStart, Uint64 renderEnd,
+                        bool sampled);
+    void writeTrace();
 
     // SDL関連
     SDL_Window* window;
     SDL_Renderer* renderer;
+    bool headless;
     TTF_Font* font;
+    std::string fontPath;
 
-    // ゲーム状態
-    GameState gameState;
-    Uint32 gameOverTime;
+    // 非同期のアセット読み込み
+    AssetLoader assetLoader;
+    Uint32 assetEventType;  // 読み込み完了の通知
+    bool assetsReady;
+    // 読み込みスレッドが書き、ready が立ってからメインスレッドが読む
+    struct FontLoad {
+        FontLoad() : font(nullptr), openMs(0), bakeMs(0) {
+            SDL_AtomicSet(&ready, 0);
+        }
 
-    // スコア関連
-    int score;
-    int successCount;
+        TTF_Font* font;
+        std::string path;
+        GlyphAtlas atlas;
+        BakedLabels countdown;  // カウントダウンの数字
+        float openMs, bakeMs;
+        SDL_atomic_t ready;
+    };
+    FontLoad fontLoad;
 
-    // タイマー関連
-    float currentTime;
-    float currentMaxTime;
-    Uint32 lastBlinkTime;
-    bool blinkOn;
+    // 起動時間の計測
+    StartupProfile startupProfile;
+    bool firstFramePresented;
+
+    // 描画の出力先（sdlBackend か softwareRasterizer）
+    SdlRenderBackend sdlBackend;
+    SoftwareRasterizer softwareRasterizer;
+    RenderBackend* backend;
+    bool softwareRaster;
 
-    // 色関連
-    SDL_Color wallTopColor, wallBottomColor, wallLeftColor, wallRightColor;
-    SDL_Color directiveColor;
+    TextRenderer textRenderer;
+    CircleSprite playerSprite;
+    LabelSprites countdownLabels;
+    // 1フレーム分の描画を溜めてまとめて送るキュー
+    RenderQueue renderQueue;
 
-    // プレイヤー
-    Player player;
+    // 壁・指示枠・スコアを描画バックエンドのレイヤーに焼き込む
+    // 作成時の色とスコアを覚えておき、変わったら作り直す
+    bool staticLayerValid;
+    RoundDescriptor staticLayerRound;
+    int staticLayerScore;
+
+    // 整形済みのスコア表示（スコアが変わったときだけ作り直す）
+    int formattedScore;
+    char scoreText[32];
+    char finalScoreText[32];
+
+    // ゲームルールの状態（SDLに依存しないシミュレーション）
+    // シミュレーションスレッドの動作中はそのスレッドだけが触る
+    SimState sim;
+    // 次の update で適用する入力
+    SimInput pendingInput;
+    // 取り込んだ移動入力（発生時刻付き）。ティックごとに取り出す
+    InputQueue inputQueue;
+    // 終了要求（メインスレッドが立て、次のティックで入力にする）
+    std::atomic<bool> quitRequested;
+
+    // シミュレーションスレッド（カウントダウン後に開始）
+    // 描画やVSyncの待ちに関係なく固定ティックで進み、毎ティックの状態を
+    // トリプルバッファで公開する。描画側は最後に公開された状態だけを読む
+    SDL_Thread* simThread;
+    std::atomic<bool> simStopRequested;
+    bool simRunning;        // カウントダウンが終わり時間が進んでいる
+    Uint64 simLastCounter;  // 以下2つはシミュレーション側の経過時間
+    Uint64 simAccumulator;
+    TripleBuffer<SimSnapshot> snapshots;
+    SimSnapshot view;  // 描画に使う状態（メインスレッド）
+
+    // 受け付けた入力の遅延計測の時刻（シミュレーション側で記録）
+    InputLatencyStamp inputStamp;
+    bool inputStampPending;
+    Uint32 lastInputSerial;  // 計測を始めた入力（メインスレッド）
+
+    // 開始前のカウントダウン（表示専用。シミュレーションは進めないので
+    // 記録・再生には含まれない）
+    Uint32 countdownStart;
+    int countdownStep;  // 表示中のラベルの番号
+
+    // 固定ティック
+    Uint32 tickMs;
+    Uint32 tickCount;
+    bool vsyncEnabled;
+
+    // 入力の記録・再生
+    Uint32 randomSeed;
+    InputRecording recording;
+    std::string recordPath;
+    bool replayMode;
+
+    // 直前ティックのプレイヤー位置（描画補間用、スナップショットに載せる）
+    float prevPlayerX, prevPlayerY;
+    // 直前のティックの更新にかかった時間（マイクロ秒、スナップショットへ）
+    Uint32 updateMicros;
+
+    // 省電力のフレーム制御
+    // 最後に描画したフレームの見た目を決める値を覚え、変わったときだけ描く
+    struct FrameSignature {
+        int gameState;
+        int countdownStep;
+        RoundDescriptor round;
+        int score;
+        int gaugeWidth;
+        bool blinkOn;
+        float playerX, playerY;
+        bool overlay;
+        int latencySamples;
+        Uint32 statsWindow;
+    };
+    FrameSignature getFrameSignature() const;
+
+    bool idleWait;
+    bool frameDirty;  // イベント等で描き直しが必要
+    FrameSignature lastFrame;
+    FramePacingStats pacingStats;
+
+    // メモリ使用量（テクスチャ・ヒープ・RSS）の追跡
+    MemoryTelemetry memoryTelemetry;
+
+    // 共有メモリのメトリクス（メインループが毎回書き込む）
+    std::string metricsName;
+    MetricsPublisher metricsPublisher;
+    Uint64 metricsFrameCounter;  // 直前のフレームの描画開始時刻
+
+    // 入力遅延の計測
+    LatencyProbe latencyProbe;
+    bool showLatencyOverlay;
+    std::string latencyCsvPath;
+
+    // 区間計測のトレースの出力先
+    std::string tracePath;
+
+    // 自動プレイヤー（シミュレーション側でキー入力の代わりに入力する）
+    bool botEnabled;
+    BotConfig botConfig;
+    BotPlayer bot;
+    Uint32 soakDuration;  // セッションを繰り返す時間（ミリ秒）
+    bool windowClosed;    // 終了操作があった（繰り返さずに終わる）
+    SoakStats soakStats;
+
+    // 再生中のフレームの取り込み（描画の回帰テスト）
+    FrameCaptureConfig captureConfig;
+    FrameCapture frameCapture;
+
+    // ゲージ点滅（描画専用）
+    Uint32 lastBlinkTime;
+    bool blinkOn;
 
     // 座標・矩形
     SDL_Rect topWall, bottomWall, leftWall, rightWall;
@@ -1,20 +1,99 @@
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 
 #include "game.h"
 
 int main(int argc, char* argv[]) {
-    // 乱数初期化
-    srand(static_cast<unsigned int>(time(nullptr)));
-
     // ゲームインスタンス作成
     Game game;
 
+    // 乱数初期化
+    game.setRandomSeed(static_cast<Uint32>(time(nullptr)));
+
+    // 再生中（または自動プレイヤーの実行中）のフレームの取り込み
+    FrameCaptureConfig capture;
+
+    // 自動プレイヤー（--bot）
+    bool botEnabled = false;
+    BotConfig bot;
+
+    // 再生する記録（シード・ティック長を記録の値にするため最後に読む）
+    const char* replayPath = nullptr;
+
+    // コマンドライン引数
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) {
+            game.setTickRate(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--latency-overlay") == 0) {
+            game.setLatencyOverlay(true);
+        } else if (strcmp(argv[i], "--latency-csv") == 0 && i + 1 < argc) {
+            game.setLatencyCsvPath(argv[++i]);
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            game.setTracePath(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            game.setRandomSeed(static_cast<Uint32>(strtoul(argv[++i],
+                                                           nullptr, 10)));
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            game.setRecordPath(argv[++i]);
+        } else if (strcmp(argv[i], "--no-idle-wait") == 0) {
+            game.setIdleWait(false);
+        } else if (strcmp(argv[i], "--software-raster") == 0) {
+            game.setSoftwareRaster(true);
+        } else if (strcmp(argv[i], "--headless") == 0) {
+            game.setHeadless(true);
+        } else if (strcmp(argv[i], "--capture-dir") == 0 && i + 1 < argc) {
+            capture.outputDir = argv[++i];
+        } else if (strcmp(argv[i], "--golden-dir") == 0 && i + 1 < argc) {
+            capture.goldenDir = argv[++i];
+        } else if (strcmp(argv[i], "--capture-every") == 0 && i + 1 < argc) {
+            capture.intervalTicks = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--golden-tolerance") == 0 &&
+                   i + 1 < argc) {
+            capture.channelTolerance = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--bot") == 0) {
+            botEnabled = true;
+        } else if (strcmp(argv[i], "--bot-reaction-median") == 0 &&
+                   i + 1 < argc) {
+            bot.reactionMedianMs = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--bot-reaction-sigma") == 0 &&
+                   i + 1 < argc) {
+            bot.reactionSigma = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--bot-error-rate") == 0 && i + 1 < argc) {
+            bot.errorRate = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--soak") == 0 && i + 1 < argc) {
+            botEnabled = true;
+            game.setSoakMinutes(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--metrics") == 0) {
+            game.setMetricsName(MetricsPublisher::getDefaultName());
+        } else if (strcmp(argv[i], "--metrics-name") == 0 && i + 1 < argc) {
+            game.setMetricsName(argv[++i]);
+        } else if (strcmp(argv[i], "--font") == 0 && i + 1 < argc) {
+            game.setFontPath(argv[++i]);
+        } else if (strcmp(argv[i], "--asset-dir") == 0 && i + 1 < argc) {
+            game.addAssetSearchPath(argv[++i]);
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        }
+    }
+
+    // 後ろの --seed や --tick-rate で記録の値が上書きされないようにする
+    if (replayPath && !game.loadReplay(replayPath)) {
+        return 1;
+    }
+
+    game.setFrameCapture(capture);
+    if (botEnabled) {
+        game.setBot(bot);
+    }
+
     // ゲーム初期化
-    if (game.initialize()) {
-        // ゲーム実行
-        game.runGame();
+    if (!game.initialize()) {
+        return 1;
     }
+    // ゲーム実行
+    game.runGame();
 
-    return 0;
+    // 正解画像と一致しないフレームがあれば失敗として終わる
+    return game.passedFrameCapture() ? 0 : 1;
 }
\ No newline at end of file
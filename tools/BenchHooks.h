@@ -0,0 +1,22 @@
+#pragma once
+// bench ターゲットでは全ファイルの先頭にこのヘッダを差し込み（-include）、
+// SDL の描画呼び出しの回数を数える
+//
+// 関数形式マクロは自分自身の名前を再展開しないので、
+// カウンタを増やしたあと本物の SDL 関数がそのまま呼ばれる
+#include <SDL2/SDL.h>
+
+// tools/bench.cpp で定義
+void benchCountDrawCall();
+
+#define BENCH_COUNTED(call) (benchCountDrawCall(), call)
+
+#define SDL_RenderClear(...) BENCH_COUNTED(SDL_RenderClear(__VA_ARGS__))
+#define SDL_RenderDrawLine(...) BENCH_COUNTED(SDL_RenderDrawLine(__VA_ARGS__))
+#define SDL_RenderDrawRect(...) BENCH_COUNTED(SDL_RenderDrawRect(__VA_ARGS__))
+#define SDL_RenderFillRect(...) BENCH_COUNTED(SDL_RenderFillRect(__VA_ARGS__))
+#define SDL_RenderFillRects(...) \
+    BENCH_COUNTED(SDL_RenderFillRects(__VA_ARGS__))
+#define SDL_RenderCopy(...) BENCH_COUNTED(SDL_RenderCopy(__VA_ARGS__))
+#define SDL_RenderCopyF(...) BENCH_COUNTED(SDL_RenderCopyF(__VA_ARGS__))
+#define SDL_RenderGeometry(...) BENCH_COUNTED(SDL_RenderGeometry(__VA_ARGS__))
@@ -0,0 +1,130 @@
+#pragma once
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// [0, count) の番号を複数スレッドで処理するワークスティーリング方式の
+// スレッドプール（ロックなし）
+//
+// 各ワーカーは自分の区間 [begin, end) を先頭から chunk 件ずつ取り出す。
+// 自分の区間が尽きたら他のワーカーの区間の後半を CAS で奪って続ける。
+// 区間は begin/end を1つの64ビット値に詰めて原子的に更新する
+class WorkStealingPool {
+   public:
+    // body(workerIndex, begin, end) で [begin, end) を処理する
+    template <typename Body>
+    static void run(uint32_t count, int threadCount, uint32_t chunk,
+                    Body body) {
+        if (threadCount < 1) {
+            threadCount = 1;
+        }
+        if (chunk < 1) {
+            chunk = 1;
+        }
+
+        // 最初は均等に分割して配る
+        std::unique_ptr<Slot[]> slots(new Slot[threadCount]);
+        for (int w = 0; w < threadCount; w++) {
+            uint32_t begin = static_cast<uint32_t>(
+                static_cast<uint64_t>(count) * w / threadCount);
+            uint32_t end = static_cast<uint32_t>(
+                static_cast<uint64_t>(count) * (w + 1) / threadCount);
+            slots[w].range.store(pack(begin, end));
+        }
+
+        std::vector<std::thread> threads;
+        for (int w = 1; w < threadCount; w++) {
+            threads.push_back(std::thread(worker<Body>, slots.get(),
+                                          threadCount, w, chunk, &body));
+        }
+        worker<Body>(slots.get(), threadCount, 0, chunk, &body);
+        for (size_t i = 0; i < threads.size(); i++) {
+            threads[i].join();
+        }
+    }
+
+   private:
+    // 偽共有を避けるためキャッシュライン単位で分ける
+    struct Slot {
+        std::atomic<uint64_t> range;
+        char padding[64 - sizeof(std::atomic<uint64_t>)];
+    };
+
+    static uint64_t pack(uint32_t begin, uint32_t end) {
+        return (static_cast<uint64_t>(begin) << 32) | end;
+    }
+    static uint32_t rangeBegin(uint64_t range) {
+        return static_cast<uint32_t>(range >> 32);
+    }
+    static uint32_t rangeEnd(uint64_t range) {
+        return static_cast<uint32_t>(range);
+    }
+
+    // 自分の区間の先頭から chunk 件取り出す
+    static bool takeFront(Slot& slot, uint32_t chunk, uint32_t& begin,
+                          uint32_t& end) {
+        uint64_t range = slot.range.load(std::memory_order_relaxed);
+        for (;;) {
+            uint32_t b = rangeBegin(range);
+            uint32_t e = rangeEnd(range);
+            if (b >= e) {
+                return false;
+            }
+            uint32_t nb = e - b > chunk ? b + chunk : e;
+            if (slot.range.compare_exchange_weak(range, pack(nb, e),
+                                                 std::memory_order_acq_rel)) {
+                begin = b;
+                end = nb;
+                return true;
+            }
+        }
+    }
+
+    // 他のワーカーの区間の後半を奪う
+    static bool stealBack(Slot& victim, uint32_t& begin, uint32_t& end) {
+        uint64_t range = victim.range.load(std::memory_order_relaxed);
+        for (;;) {
+            uint32_t b = rangeBegin(range);
+            uint32_t e = rangeEnd(range);
+            if (b >= e) {
+                return false;
+            }
+            uint32_t mid = b + (e - b) / 2;
+            if (victim.range.compare_exchange_weak(
+                    range, pack(b, mid), std::memory_order_acq_rel)) {
+                begin = mid;
+                end = e;
+                return true;
+            }
+        }
+    }
+
+    template <typename Body>
+    static void worker(Slot* slots, int threadCount, int self,
+                       uint32_t chunk, Body* body) {
+        for (;;) {
+            uint32_t begin, end;
+            if (takeFront(slots[self], chunk, begin, end)) {
+                (*body)(self, begin, end);
+                continue;
+            }
+
+            // 隣から順に探して奪った区間を自分の区間にする
+            bool stolen = false;
+            for (int i = 1; i < threadCount && !stolen; i++) {
+                int victim = (self + i) % threadCount;
+                stolen = stealBack(slots[victim], begin, end);
+            }
+            if (!stolen) {
+                // どこにも残っていなければ終了
+                // （奪われて移動中の区間は奪った側が処理する）
+                return;
+            }
+            slots[self].range.store(pack(begin, end),
+                                    std::memory_order_release);
+        }
+    }
+};
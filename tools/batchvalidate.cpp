@@ -0,0 +1,180 @@
+// 提出されたプレイ記録（--record で保存したファイル）をまとめて再生し、
+// スコアが正しいかを検証するサーバー側ツール
+//
+// セッションは SessionBatch に詰め、SIMD カーネルで同時に進める
+//
+// 使い方:
+//   batchvalidate [--kernel scalar|sse2|avx2] 記録ファイル...
+//   batchvalidate [--kernel ...] --selftest N
+//     ボットで N セッションを stepSimulation で記録し、
+//     SessionBatch での再生結果が一致するかとスループットを確認する
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "core/BotPlayer.h"
+#include "core/InputRecording.h"
+#include "core/SessionBatch.h"
+
+static const char* const KERNEL_NAMES[] = {"scalar", "sse2", "avx2"};
+
+// 全セッションを記録の入力で最後まで進める
+// finalTicks[i] にセッション i が終了したティック数を入れ、総ティック数を返す
+static uint64_t replayAll(SessionBatch& batch,
+                          std::vector<InputRecording>& recordings,
+                          uint32_t tickMs, std::vector<uint32_t>& finalTicks) {
+    size_t n = recordings.size();
+    finalTicks.assign(n, 0);
+    std::vector<bool> finished(n, false);
+    size_t remaining = n;
+    uint64_t sessionTicks = 0;
+
+    for (uint32_t tick = 0; remaining > 0; tick++) {
+        for (size_t i = 0; i < n; i++) {
+            if (finished[i]) {
+                continue;
+            }
+            if (batch.isFinished(i)) {
+                finished[i] = true;
+                finalTicks[i] = tick;
+                remaining--;
+                continue;
+            }
+            SimInput input;
+            if (recordings[i].nextInput(tick, input)) {
+                batch.applyInput(i, input, tickMs);
+            }
+        }
+        if (remaining == 0) {
+            break;
+        }
+        batch.step(tickMs);
+        sessionTicks += remaining;
+    }
+    return sessionTicks;
+}
+
+// ボットのセッションを stepSimulation で回して記録を作る
+static void recordBotSessions(int sessions,
+                              std::vector<InputRecording>& recordings,
+                              std::vector<SimState>& results,
+                              uint32_t tickMs) {
+    BotConfig config;
+    for (int s = 0; s < sessions; s++) {
+        uint32_t seed = static_cast<uint32_t>(s + 1);
+        SimState state;
+        state.rng.seed(seed);
+        resetRound(state);
+        BotPlayer bot(config, seed * 7919ULL);
+
+        InputRecording recording;
+        recording.reset(seed, tickMs);
+        uint32_t tick = 0;
+        while (!isSessionFinished(state)) {
+            SimInput input = bot.think(state);
+            recording.addInput(tick, input);
+            stepSimulation(state, input, tickMs);
+            tick++;
+        }
+        recording.setResult(tick, state.score);
+        recordings.push_back(recording);
+        results.push_back(state);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    SessionBatch batch;
+    int selftest = 0;
+    std::vector<const char*> paths;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--kernel") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            for (int k = 0; k < 3; k++) {
+                if (strcmp(name, KERNEL_NAMES[k]) == 0) {
+                    batch.setKernel(static_cast<SessionBatch::Kernel>(k));
+                }
+            }
+        } else if (strcmp(argv[i], "--selftest") == 0 && i + 1 < argc) {
+            selftest = atoi(argv[++i]);
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    printf("kernel   : %s\n", KERNEL_NAMES[batch.getKernel()]);
+
+    std::vector<InputRecording> recordings;
+    std::vector<SimState> expected;
+    uint32_t tickMs = 1000 / DEFAULT_TICK_RATE;
+
+    if (selftest > 0) {
+        recordBotSessions(selftest, recordings, expected, tickMs);
+    } else {
+        for (size_t i = 0; i < paths.size(); i++) {
+            InputRecording recording;
+            if (!recording.load(paths[i])) {
+                fprintf(stderr, "failed to load %s\n", paths[i]);
+                return 1;
+            }
+            if (i == 0) {
+                tickMs = recording.getTickMs();
+            } else if (recording.getTickMs() != tickMs) {
+                // 1つのバッチは同じティック長で進める
+                fprintf(stderr, "%s: tick %u ms differs from %u ms\n",
+                        paths[i], recording.getTickMs(), tickMs);
+                return 1;
+            }
+            recordings.push_back(recording);
+        }
+    }
+    if (recordings.empty()) {
+        fprintf(stderr,
+                "usage: batchvalidate [--kernel scalar|sse2|avx2] "
+                "(--selftest N | recording...)\n");
+        return 1;
+    }
+
+    for (size_t i = 0; i < recordings.size(); i++) {
+        batch.add(recordings[i].getSeed());
+    }
+
+    std::vector<uint32_t> finalTicks;
+    std::chrono::steady_clock::time_point begin =
+        std::chrono::steady_clock::now();
+    uint64_t sessionTicks = replayAll(batch, recordings, tickMs, finalTicks);
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - begin)
+                         .count();
+
+    // 記録された結果と照合する
+    int invalid = 0;
+    for (size_t i = 0; i < recordings.size(); i++) {
+        // 終了したティックも照合する（スコアだけ合わせた記録を弾く）
+        bool valid = batch.getScore(i) == recordings[i].getFinalScore() &&
+                     finalTicks[i] == recordings[i].getFinalTick();
+        if (selftest > 0) {
+            valid = valid &&
+                    batch.getGameOverTime(i) == expected[i].gameOverTime &&
+                    batch.getCurrentTime(i) == expected[i].currentTime &&
+                    batch.getPlayerX(i) == expected[i].player.getX() &&
+                    batch.getPlayerY(i) == expected[i].player.getY();
+        } else {
+            printf("%s: score %d (submitted %d), tick %u (submitted %u) %s\n",
+                   paths[i], batch.getScore(i), recordings[i].getFinalScore(),
+                   finalTicks[i], recordings[i].getFinalTick(),
+                   valid ? "VALID" : "INVALID");
+        }
+        if (!valid) {
+            invalid++;
+        }
+    }
+
+    printf("sessions : %zu (%d invalid)\n", recordings.size(), invalid);
+    printf("elapsed  : %.3f s (%.1f M session-ticks/s)\n", seconds,
+           seconds > 0 ? sessionTicks / seconds / 1e6 : 0.0);
+
+    return invalid == 0 ? 0 : 2;
+}
@@ -0,0 +1,373 @@
+// 更新・描画・文字描画のマイクロベンチマーク
+//
+// 各ケースを一定時間以上回し、1回あたりの時間（ns/op）、ヒープ確保回数
+// （allocs/op）、SDL の描画呼び出し回数（draw calls/op）を JSON で出力する。
+// 変更ごとに前回の JSON と比べて退行を確認する
+//
+// 描画のケースはダミーのビデオドライバ上のソフトウェアレンダラーで回すので、
+// ディスプレイの無い環境でも動く。SDL_Renderer の経路と CPU のラスタライザ
+// （名前に [software] が付く）の両方を同じ内容で計測する
+//
+// 使い方:
+//   bench [--min-time ms] [--filter 名前の一部] [--font path] [--out path]
+//         [--ppm path]
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "Constants.h"
+#include "PlayerRenderer.h"
+#include "core/BotPlayer.h"
+#include "game.h"
+
+// ---- 計数 ----
+
+static std::atomic<uint64_t> allocationCount(0);
+static std::atomic<uint64_t> drawCallCount(0);
+
+void benchCountDrawCall() {
+    drawCallCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+// C++ 側の確保はグローバルな operator new を置き換えて数える
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* p = malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+
+// SDL 内部の確保は SDL_SetMemoryFunctions で差し替えて数える
+static SDL_malloc_func sdlMalloc;
+static SDL_calloc_func sdlCalloc;
+static SDL_realloc_func sdlRealloc;
+static SDL_free_func sdlFree;
+
+static void* countingMalloc(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return sdlMalloc(size);
+}
+
+static void* countingCalloc(size_t count, size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return sdlCalloc(count, size);
+}
+
+static void* countingRealloc(void* p, size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return sdlRealloc(p, size);
+}
+
+static void countingFree(void* p) { sdlFree(p); }
+
+static void installSdlAllocationHook() {
+    SDL_GetMemoryFunctions(&sdlMalloc, &sdlCalloc, &sdlRealloc, &sdlFree);
+    SDL_SetMemoryFunctions(countingMalloc, countingCalloc, countingRealloc,
+                           countingFree);
+}
+
+// ---- Game の内部処理を呼ぶための窓口（Game の friend） ----
+
+class GameBench {
+   public:
+    explicit GameBench(Game& game)
+        : game(game), bot(BotConfig(), 12345) {}
+
+    SDL_Renderer* getRenderer() { return game.renderer; }
+    RenderBackend& getBackend() { return *game.backend; }
+    SoftwareRasterizer& getSoftwareRasterizer() {
+        return game.softwareRasterizer;
+    }
+    const CircleSprite* getPlayerSprite() { return &game.playerSprite; }
+    RenderQueue& getRenderQueue() { return game.renderQueue; }
+
+    // ボットの入力で1ティック進める（終わったセッションは作り直す）
+    void update() {
+        if (isSessionFinished(game.sim)) {
+            game.recording.reset(game.randomSeed, game.tickMs);
+            game.tickCount = 0;
+            game.initRound();
+            bot.reset();
+        }
+        game.pendingInput = bot.think(game.sim);
+        game.update(game.tickMs);
+        game.publishSnapshot(SDL_GetPerformanceCounter());
+    }
+
+    // 最後に公開された状態を描画する
+    void render(float alpha) {
+        game.acquireSnapshot();
+        game.render(alpha);
+    }
+
+    // 次の render で静的レイヤーを作り直させる
+    void invalidateStaticLayer() { game.staticLayerValid = false; }
+
+    void renderText(const char* message) {
+        game.renderText(message, WHITE, SCORE_POS_X, SCORE_POS_Y);
+    }
+
+   private:
+    Game& game;
+    BotPlayer bot;
+};
+
+// ---- 計測 ----
+
+struct BenchResult {
+    std::string name;
+    uint64_t iterations;
+    double nsPerOp;
+    double allocsPerOp;
+    double drawCallsPerOp;
+};
+
+// body を iterations 回呼んだ結果を返す
+template <typename Body>
+static BenchResult measure(const char* name, uint64_t iterations, Body& body) {
+    uint64_t allocsBefore = allocationCount.load();
+    uint64_t drawsBefore = drawCallCount.load();
+    std::chrono::steady_clock::time_point begin =
+        std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; i++) {
+        body();
+    }
+    double ns = std::chrono::duration<double, std::nano>(
+                    std::chrono::steady_clock::now() - begin)
+                    .count();
+
+    BenchResult result;
+    result.name = name;
+    result.iterations = iterations;
+    result.nsPerOp = ns / iterations;
+    result.allocsPerOp =
+        static_cast<double>(allocationCount.load() - allocsBefore) /
+        iterations;
+    result.drawCallsPerOp =
+        static_cast<double>(drawCallCount.load() - drawsBefore) / iterations;
+    return result;
+}
+
+// 回数を倍々に増やし、minTimeMs 以上かかった回の結果を採用する
+template <typename Body>
+static BenchResult runBench(const char* name, double minTimeMs, Body body) {
+    // 初回のキャッシュやテクスチャ生成を計測から外す
+    measure(name, 1, body);
+
+    uint64_t iterations = 1;
+    for (;;) {
+        BenchResult result = measure(name, iterations, body);
+        if (result.nsPerOp * iterations >= minTimeMs * 1e6 ||
+            iterations >= (1ULL << 40)) {
+            return result;
+        }
+        iterations *= 2;
+    }
+}
+
+// 名前で絞り込みながらケースを順に回し、結果を集める
+class BenchSuite {
+   public:
+    BenchSuite(const char* filter, double minTimeMs)
+        : filter(filter), minTimeMs(minTimeMs) {}
+
+    template <typename Body>
+    void run(const char* name, Body body) {
+        if (filter && !strstr(name, filter)) {
+            return;
+        }
+        results.push_back(runBench(name, minTimeMs, body));
+        fprintf(stderr, "%-32s %12.1f ns/op\n", name, results.back().nsPerOp);
+    }
+
+    const std::vector<BenchResult>& getResults() const { return results; }
+
+   private:
+    const char* filter;
+    double minTimeMs;
+    std::vector<BenchResult> results;
+};
+
+static void writeJson(FILE* out, const std::vector<BenchResult>& results) {
+    fprintf(out, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        fprintf(out,
+                "    {\"name\": \"%s\", \"iterations\": %llu, "
+                "\"ns_per_op\": %.2f, \"allocs_per_op\": %.4f, "
+                "\"draw_calls_per_op\": %.4f}%s\n",
+                r.name.c_str(), static_cast<unsigned long long>(r.iterations),
+                r.nsPerOp, r.allocsPerOp, r.drawCallsPerOp,
+                i + 1 < results.size() ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+}
+
+// 最適化で結果が捨てられないよう書き込む先
+static volatile int sink;
+
+// 画面を持たないソフトウェア描画で初期化する
+static bool initializeGame(Game& game, const char* fontPath,
+                           bool softwareRaster) {
+    game.setRandomSeed(1);
+    game.setSoftwareRaster(softwareRaster);
+    if (fontPath) {
+        game.setFontPath(fontPath);
+    }
+    if (!game.initialize()) {
+        fprintf(stderr, "failed to initialize the offscreen renderer\n");
+        return false;
+    }
+    // フォントは別スレッドで読み込まれるので、揃ってから計測する
+    if (!game.finishLoadingAssets()) {
+        fprintf(stderr, "no font loaded; text cases measure nothing\n");
+    }
+    return true;
+}
+
+static void runSimulationCases(BenchSuite& suite, GameBench& access) {
+    suite.run("Game::update", [&]() { access.update(); });
+
+    Player player;
+    uint32_t playerNow = 0;
+    suite.run("Player::update", [&]() {
+        // 移動の開始から完了までを1周として繰り返す
+        if (playerNow % MOVE_DURATION == 0) {
+            int lap = static_cast<int>(playerNow / MOVE_DURATION);
+            player.reset();
+            player.setMovementTarget(static_cast<Direction>(DIR_UP + lap % 4),
+                                     playerNow);
+        }
+        playerNow++;
+        player.update(playerNow);
+        sink = static_cast<int>(player.getX());
+    });
+
+    RoundDescriptor round = 0;
+    suite.run("Player::checkCollision", [&]() {
+        round = static_cast<RoundDescriptor>((round + 1) &
+                                             (ROUND_TABLE_SIZE - 1));
+        sink = player.checkCollision(
+            static_cast<Direction>(DIR_UP + (round & 3)), round);
+    });
+
+    SimState colorState;
+    colorState.rng.seed(1);
+    suite.run("randomizeColors", [&]() {
+        randomizeColors(colorState);
+        sink = colorState.round;
+    });
+}
+
+// 描画キューとバックエンド内のコマンドを1回ごとにフラッシュして
+// ラスタライズまでを計測に含める。suffix はケース名の後ろに付ける
+static void runRenderCases(BenchSuite& suite, GameBench& access,
+                           const std::string& suffix) {
+    SDL_Renderer* renderer = access.getRenderer();
+    RenderBackend& backend = access.getBackend();
+    RenderQueue& queue = access.getRenderQueue();
+    suite.run(("renderText" + suffix).c_str(), [&]() {
+        access.renderText("Score: 1234");
+        queue.flush(backend);
+        SDL_RenderFlush(renderer);
+    });
+
+    const CircleSprite* sprite = access.getPlayerSprite();
+    suite.run(("renderPlayer" + suffix).c_str(), [&]() {
+        renderPlayer(queue, WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f, sprite);
+        queue.flush(backend);
+        SDL_RenderFlush(renderer);
+    });
+
+    suite.run(("Game::render" + suffix).c_str(),
+              [&]() { access.render(0.5f); });
+
+    // 色かスコアが変わったフレーム（静的レイヤーの作り直しを含む）
+    suite.run(("Game::render/rebuild" + suffix).c_str(), [&]() {
+        access.invalidateStaticLayer();
+        access.render(0.5f);
+    });
+}
+
+int main(int argc, char* argv[]) {
+    double minTimeMs = 200.0;
+    const char* filter = nullptr;
+    const char* outPath = nullptr;
+    const char* fontPath = nullptr;
+    const char* ppmPath = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            minTimeMs = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--font") == 0 && i + 1 < argc) {
+            fontPath = argv[++i];
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        } else if (strcmp(argv[i], "--ppm") == 0 && i + 1 < argc) {
+            ppmPath = argv[++i];
+        }
+    }
+
+    installSdlAllocationHook();
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    SDL_SetHint(SDL_HINT_RENDER_VSYNC, "0");
+
+    BenchSuite suite(filter, minTimeMs);
+
+    // ---- 描画（SDL_Renderer）・シミュレーション ----
+    // 描画はどちらのバックエンドも初期化直後の同じ状態を描くので、
+    // 状態を進めるシミュレーションのケースは後に回す
+    {
+        Game game;
+        if (!initializeGame(game, fontPath, false)) {
+            return 1;
+        }
+        GameBench access(game);
+        runRenderCases(suite, access, "");
+        runSimulationCases(suite, access);
+    }
+
+    // ---- 描画（CPU のラスタライザ） ----
+    // SDL ごと作り直し、テクスチャを CPU 側に持つバックエンドで同じ描画を回す
+    {
+        Game game;
+        if (!initializeGame(game, fontPath, true)) {
+            return 1;
+        }
+        GameBench access(game);
+        runRenderCases(suite, access, "[software]");
+        if (ppmPath) {
+            if (!access.getSoftwareRasterizer().writePpm(ppmPath)) {
+                fprintf(stderr, "failed to write %s\n", ppmPath);
+            }
+        }
+    }
+
+    FILE* out = stdout;
+    if (outPath) {
+        out = fopen(outPath, "w");
+        if (!out) {
+            fprintf(stderr, "failed to open %s\n", outPath);
+            return 1;
+        }
+    }
+    writeJson(out, suite.getResults());
+    if (out != stdout) {
+        fclose(out);
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+// SDLを使わずにゲームルールだけを高速に回すヘッドレス実行
+//
+// 使い方: headless [セッション数] [乱数シード] [ミス率]
+// 各セッションは BotPlayer が正解の壁へ一定の反応時間で移動し、
+// ミス率の確率で誤った方向へ移動する
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "core/BotPlayer.h"
+#include "core/Simulation.h"
+
+// 1ステップの時間（ミリ秒）：ゲーム本体と同じ固定ティック
+static const uint32_t STEP_MS = 1000 / DEFAULT_TICK_RATE;
+// ボットの反応時間（ミリ秒）
+static const double BOT_REACTION_MS = 250.0;
+// 1セッションあたりの最大ラウンド数（ミスしないボットの暴走防止）
+static const int MAX_ROUNDS_PER_SESSION = 100000;
+
+int main(int argc, char* argv[]) {
+    long sessions = argc > 1 ? atol(argv[1]) : 100000;
+    unsigned int seed = argc > 2 ? static_cast<unsigned int>(atol(argv[2])) : 1;
+    double errorRate = argc > 3 ? atof(argv[3]) : 0.02;
+
+    // セッションごとに独立した乱数系列を派生させる
+    Random master(seed);
+
+    BotConfig botConfig;
+    botConfig.reactionMedianMs = BOT_REACTION_MS;
+    botConfig.reactionSigma = 0.0;
+    botConfig.errorRate = errorRate;
+    BotPlayer bot(botConfig, master.split().next());
+
+    long long totalRounds = 0;
+    long long totalSteps = 0;
+    int bestScore = 0;
+
+    std::chrono::steady_clock::time_point begin =
+        std::chrono::steady_clock::now();
+
+    for (long i = 0; i < sessions; i++) {
+        SimState state;
+        state.rng = master.split();
+        resetRound(state);
+        bot.reset();
+
+        while (!isSessionFinished(state)) {
+            SimInput input = bot.think(state);
+            if (state.score >= MAX_ROUNDS_PER_SESSION) {
+                input.quit = true;
+            }
+            stepSimulation(state, input, STEP_MS);
+            totalSteps++;
+        }
+
+        totalRounds += state.score + 1;
+        if (state.score > bestScore) {
+            bestScore = state.score;
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - begin)
+                         .count();
+
+    printf("sessions      : %ld\n", sessions);
+    printf("rounds        : %lld\n", totalRounds);
+    printf("steps         : %lld\n", totalSteps);
+    printf("average score : %.3f\n",
+           sessions > 0 ? static_cast<double>(totalRounds - sessions) / sessions
+                        : 0.0);
+    printf("best score    : %d\n", bestScore);
+    printf("elapsed       : %.3f s\n", seconds);
+    if (seconds > 0) {
+        printf("rounds/sec    : %.0f\n", totalRounds / seconds);
+    }
+
+    return 0;
+}
@@ -0,0 +1,250 @@
+// 実行中のゲームが共有メモリに公開しているメトリクスを読むツール
+//
+// ゲームを --metrics（または --metrics-name）付きで起動しておき、その
+// プロセスIDか共有メモリの名前を指定する。ゲームの処理には一切関与せず、
+// seqlock で一貫した値を読み出すまで読み直すだけ
+//
+// 使い方: metrics [オプション] <プロセスID | 共有メモリの名前>
+//   --prometheus   Prometheus のテキスト形式で出力
+//   --watch MS     MS ミリ秒ごとに繰り返し出力（Ctrl+C で終了）
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "MetricsBlock.h"
+#include "core/Rules.h"
+
+// 書き込みと重なったときに読み直す回数
+static const int READ_TRIES = 1000;
+
+static const char* const STATE_NAMES[] = {"countdown", "playing", "moving",
+                                          "gameover"};
+
+static const char* stateName(int32_t state) {
+    if (state < STATE_COUNTDOWN || state > STATE_GAMEOVER) {
+        return "unknown";
+    }
+    return STATE_NAMES[state];
+}
+
+// プロセスIDだけなら既定の名前にする
+static std::string resolveName(const char* target) {
+    bool digits = *target != '\0';
+    for (const char* p = target; *p; p++) {
+        digits = digits && isdigit(static_cast<unsigned char>(*p));
+    }
+    if (digits) {
+        return std::string(METRICS_SHM_PREFIX) + target;
+    }
+    if (*target != '/') {
+        return std::string("/") + target;
+    }
+    return target;
+}
+
+static const MetricsBlock* openBlock(const std::string& name) {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        fprintf(stderr, "metrics: cannot open shared memory %s\n",
+                name.c_str());
+        return nullptr;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 ||
+        info.st_size < static_cast<off_t>(sizeof(MetricsBlock))) {
+        fprintf(stderr, "metrics: %s is too small\n", name.c_str());
+        close(fd);
+        return nullptr;
+    }
+    void* memory =
+        mmap(nullptr, sizeof(MetricsBlock), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        fprintf(stderr, "metrics: cannot map %s\n", name.c_str());
+        return nullptr;
+    }
+
+    const MetricsBlock* block = static_cast<const MetricsBlock*>(memory);
+    if (block->magic != METRICS_MAGIC || block->version != METRICS_VERSION ||
+        block->size != sizeof(MetricsBlock)) {
+        fprintf(stderr,
+                "metrics: %s has an unknown layout (version %u, size %u)\n",
+                name.c_str(), block->version, block->size);
+        munmap(memory, sizeof(MetricsBlock));
+        return nullptr;
+    }
+    return block;
+}
+
+static void printText(const MetricsBlock* block, const MetricsData& m,
+                      bool alive) {
+    const double MB = 1024.0 * 1024.0;
+    printf("pid %u%s\n", block->pid, alive ? "" : " (not running)");
+    printf("state %s, score %d, game time %.1f s\n", stateName(m.gameState),
+           m.score, m.simTime / 1000.0);
+    printf("frames %llu (%u/s), interval %.2f ms, render %.2f ms, "
+           "update %.3f ms\n",
+           static_cast<unsigned long long>(m.frames), m.framesPerSecond,
+           m.frameIntervalUs / 1000.0, m.renderUs / 1000.0,
+           m.updateUs / 1000.0);
+    printf("latency p50 %.1f p95 %.1f p99 %.1f ms (n=%u)\n", m.latencyP50Ms,
+           m.latencyP95Ms, m.latencyP99Ms, m.latencySamples);
+    printf("allocations %llu, textures created %llu (%.2f MB)\n",
+           static_cast<unsigned long long>(m.allocations),
+           static_cast<unsigned long long>(m.texturesCreated),
+           m.textureBytes / MB);
+    printf("heap %.1f MB, RSS %.1f MB\n", m.heapBytes / MB,
+           m.residentBytes / MB);
+}
+
+static void printMetric(const char* name, const char* type, const char* help,
+                        const char* labels, double value) {
+    printf("# HELP %s %s\n# TYPE %s %s\n%s{%s} %.17g\n", name, help, name,
+           type, name, labels, value);
+}
+
+static void printPrometheus(const MetricsBlock* block, const MetricsData& m,
+                            bool alive) {
+    char labels[32];
+    snprintf(labels, sizeof(labels), "pid=\"%u\"", block->pid);
+
+    printMetric("color_wall_up", "gauge",
+                "Whether the game process is running.", labels, alive ? 1 : 0);
+    printMetric("color_wall_frames_total", "counter", "Frames rendered.",
+                labels, static_cast<double>(m.frames));
+    printMetric("color_wall_frames_per_second", "gauge",
+                "Frames rendered in the last second.", labels,
+                m.framesPerSecond);
+    printMetric("color_wall_frame_interval_seconds", "gauge",
+                "Time between the last two frames.", labels,
+                m.frameIntervalUs / 1e6);
+    printMetric("color_wall_render_seconds", "gauge",
+                "Time spent rendering the last frame.", labels,
+                m.renderUs / 1e6);
+    printMetric("color_wall_update_seconds", "gauge",
+                "Time spent updating the last simulation tick.", labels,
+                m.updateUs / 1e6);
+
+    // 入力遅延は summary として分位点を並べる
+    printf("# HELP color_wall_input_latency_seconds Input to present latency "
+           "over recent samples.\n"
+           "# TYPE color_wall_input_latency_seconds summary\n");
+    const double quantiles[3] = {0.5, 0.95, 0.99};
+    const float values[3] = {m.latencyP50Ms, m.latencyP95Ms, m.latencyP99Ms};
+    for (int i = 0; i < 3; i++) {
+        printf("color_wall_input_latency_seconds{%s,quantile=\"%g\"} %g\n",
+               labels, quantiles[i], values[i] / 1000.0);
+    }
+    printf("color_wall_input_latency_seconds_count{%s} %u\n", labels,
+           m.latencySamples);
+
+    printMetric("color_wall_score", "gauge", "Current score.", labels,
+                m.score);
+    printMetric("color_wall_game_time_seconds", "gauge",
+                "In-game time of the current session.", labels,
+                m.simTime / 1000.0);
+    // 状態はラベルで表し、現在の状態だけ 1 にする
+    printf("# HELP color_wall_state Current game state.\n"
+           "# TYPE color_wall_state gauge\n");
+    for (int s = STATE_COUNTDOWN; s <= STATE_GAMEOVER; s++) {
+        printf("color_wall_state{%s,state=\"%s\"} %d\n", labels,
+               STATE_NAMES[s], m.gameState == s ? 1 : 0);
+    }
+    printMetric("color_wall_allocations_total", "counter",
+                "Heap allocations (alloccheck builds only).", labels,
+                static_cast<double>(m.allocations));
+    printMetric("color_wall_textures_created_total", "counter",
+                "Textures created.", labels,
+                static_cast<double>(m.texturesCreated));
+    printMetric("color_wall_texture_bytes", "gauge", "Texture pixel memory.",
+                labels, static_cast<double>(m.textureBytes));
+    printMetric("color_wall_heap_bytes", "gauge", "Heap bytes in use.",
+                labels, static_cast<double>(m.heapBytes));
+    printMetric("color_wall_resident_bytes", "gauge", "Resident set size.",
+                labels, static_cast<double>(m.residentBytes));
+}
+
+// 書き込みの途中で止まった書き手（値は一貫していない）
+static void printStopped(const MetricsBlock* block, bool prometheus) {
+    if (prometheus) {
+        char labels[32];
+        snprintf(labels, sizeof(labels), "pid=\"%u\"", block->pid);
+        printMetric("color_wall_up", "gauge",
+                    "Whether the game process is running.", labels, 0);
+    } else {
+        printf("pid %u (not running, stopped during an update)\n",
+               block->pid);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    bool prometheus = false;
+    int watchMs = 0;
+    const char* target = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--prometheus") == 0) {
+            prometheus = true;
+        } else if (strcmp(argv[i], "--watch") == 0 && i + 1 < argc) {
+            watchMs = atoi(argv[++i]);
+        } else if (argv[i][0] != '-') {
+            target = argv[i];
+        } else {
+            target = nullptr;
+            break;
+        }
+    }
+    if (!target) {
+        fprintf(stderr,
+                "usage: metrics [--prometheus] [--watch MS] <pid | name>\n");
+        return 2;
+    }
+
+    std::string name = resolveName(target);
+    const MetricsBlock* block = openBlock(name);
+    if (!block) {
+        return 1;
+    }
+
+    for (;;) {
+        // 書き手が異常終了すると共有メモリが残るので、先に生存を確かめる
+        // （書き込みの途中で止まった場合は sequence が奇数のまま残る）
+        bool alive = kill(static_cast<pid_t>(block->pid), 0) == 0 ||
+                     errno == EPERM;
+        MetricsData data;
+        if (readMetrics(block, data, READ_TRIES)) {
+            if (prometheus) {
+                printPrometheus(block, data, alive);
+            } else {
+                printText(block, data, alive);
+            }
+        } else if (!alive) {
+            // 値は書きかけなので出さず、止まっていることだけ報告する
+            printStopped(block, prometheus);
+        } else {
+            fprintf(stderr, "metrics: no consistent snapshot in %s\n",
+                    name.c_str());
+            return 1;
+        }
+        if (watchMs <= 0) {
+            break;
+        }
+        printf("\n");
+        fflush(stdout);
+        struct timespec wait;
+        wait.tv_sec = watchMs / 1000;
+        wait.tv_nsec = static_cast<long>(watchMs % 1000) * 1000000;
+        nanosleep(&wait, nullptr);
+    }
+    return 0;
+}
@@ -0,0 +1,304 @@
+// 難易度バランス調査用のモンテカルロシミュレータ
+//
+// ゲームルール（src/core）とボットの反応時間モデルで独立したセッションを
+// 大量に回し、スコア分布とゲームオーバー時刻の分布を集計する。
+// セッションはワークスティーリング方式で全コアに分配し、集計はスレッド
+// ごとの領域に書いてから最後にまとめる（実行中のロック・共有書き込みなし）
+//
+// 使い方: montecarlo [オプション]
+//   --sessions N          セッション数（既定 1000000）
+//   --threads N           スレッド数（既定 全コア）
+//   --seed N              乱数シード（既定 1）
+//   --reaction-median MS  反応時間の中央値（既定 350）
+//   --reaction-sigma S    反応時間の対数正規分布のσ（既定 0.25）
+//   --error-rate P        誤った方向へ動く確率（既定 0.02）
+//   --tick-rate HZ        ティックレート（1000 の約数、既定 DEFAULT_TICK_RATE）
+//   --max-rounds N        1セッションの最大ラウンド数（既定 100000）
+//   --csv PATH            ヒストグラムをCSVに出力
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "WorkStealingPool.h"
+#include "core/BotPlayer.h"
+#include "core/Simulation.h"
+
+// ヒストグラムの区間数（最後の区間はそれ以上をまとめる）
+static const int SCORE_BUCKETS = 1024;  // スコア 1点刻み
+static const int DEATH_BUCKETS = 600;   // ゲームオーバー時刻 1秒刻み
+
+// 一度に取り出すセッション数
+static const uint32_t SESSION_CHUNK = 256;
+
+// ゲームオーバーの原因
+enum DeathCause { DEATH_TIMEOUT, DEATH_WRONG_WALL, DEATH_CAPPED };
+
+// スレッドごとの集計（他スレッドとは共有しない）
+struct Accumulator {
+    uint64_t sessions;
+    uint64_t rounds;
+    uint64_t causes[3];
+    uint64_t scoreHistogram[SCORE_BUCKETS];
+    uint64_t deathHistogram[DEATH_BUCKETS];
+    char padding[64];  // 隣のスレッドの領域と同じキャッシュラインにしない
+
+    Accumulator() { memset(this, 0, sizeof(*this)); }
+
+    void merge(const Accumulator& other) {
+        sessions += other.sessions;
+        rounds += other.rounds;
+        for (int i = 0; i < 3; i++) causes[i] += other.causes[i];
+        for (int i = 0; i < SCORE_BUCKETS; i++)
+            scoreHistogram[i] += other.scoreHistogram[i];
+        for (int i = 0; i < DEATH_BUCKETS; i++)
+            deathHistogram[i] += other.deathHistogram[i];
+    }
+};
+
+struct Options {
+    uint32_t sessions;
+    int threads;
+    uint64_t seed;
+    BotConfig bot;
+    uint32_t tickMs;
+    int maxRounds;
+    const char* csvPath;
+};
+
+// セッション番号からシードを作る（スレッドの割り当てに依存しない）
+static uint64_t sessionSeed(uint64_t seed, uint32_t index) {
+    return seed * 0x9E3779B97F4A7C15ULL + index;
+}
+
+static uint32_t ticksFor(uint32_t ms, uint32_t tickMs) {
+    return (ms + tickMs - 1) / tickMs;
+}
+
+// 1セッションを最後まで回す
+//
+// 毎ティック入力を確認する本体のループと同じ結果になるよう、
+// 反応時間・移動時間・残り時間をティック境界に切り上げ、
+// 次に何かが起きる時刻まで1回の stepSimulation でまとめて進める
+static DeathCause runSession(SimState& state, BotPlayer& bot,
+                             const Options& options) {
+    const uint32_t tickMs = options.tickMs;
+    const uint32_t moveTicks = ticksFor(MOVE_DURATION, tickMs);
+    resetRound(state);
+    bot.reset();
+
+    for (;;) {
+        if (state.score >= options.maxRounds) {
+            SimInput quit;
+            quit.quit = true;
+            stepSimulation(state, quit, 0);
+            return DEATH_CAPPED;
+        }
+
+        bot.planRound(state);
+        uint32_t reactionTicks = ticksFor(bot.getPlannedReaction(), tickMs);
+        uint32_t remainingTicks = ticksFor(state.currentTime, tickMs);
+
+        // 反応する前に時間切れ
+        if (reactionTicks >= remainingTicks) {
+            stepSimulation(state, SimInput(), remainingTicks * tickMs);
+            return DEATH_TIMEOUT;
+        }
+        if (reactionTicks > 0) {
+            stepSimulation(state, SimInput(), reactionTicks * tickMs);
+        }
+
+        // 移動開始から完了（または時間切れ）まで
+        SimInput input;
+        input.dir = bot.getPlannedDirection();
+        remainingTicks = ticksFor(state.currentTime, tickMs);
+        uint32_t stepTicks =
+            moveTicks < remainingTicks ? moveTicks : remainingTicks;
+        stepSimulation(state, input, stepTicks * tickMs);
+
+        if (state.gameState == STATE_GAMEOVER) {
+            return state.player.isMovementComplete(state.now) &&
+                           state.currentTime > 0
+                       ? DEATH_WRONG_WALL
+                       : DEATH_TIMEOUT;
+        }
+    }
+}
+
+static void record(Accumulator& acc, const SimState& state, DeathCause cause) {
+    acc.sessions++;
+    acc.rounds += state.score + 1;
+    acc.causes[cause]++;
+
+    int scoreBucket = state.score < SCORE_BUCKETS ? state.score
+                                                  : SCORE_BUCKETS - 1;
+    acc.scoreHistogram[scoreBucket]++;
+
+    uint32_t deathSecond = state.gameOverTime / 1000;
+    int deathBucket = deathSecond < static_cast<uint32_t>(DEATH_BUCKETS)
+                          ? static_cast<int>(deathSecond)
+                          : DEATH_BUCKETS - 1;
+    acc.deathHistogram[deathBucket]++;
+}
+
+// ヒストグラムからパーセンタイルの区間を求める
+static int histogramPercentile(const uint64_t* histogram, int buckets,
+                               uint64_t total, double p) {
+    uint64_t target = static_cast<uint64_t>(total * p);
+    uint64_t sum = 0;
+    for (int i = 0; i < buckets; i++) {
+        sum += histogram[i];
+        if (sum > target) {
+            return i;
+        }
+    }
+    return buckets - 1;
+}
+
+static bool parseOptions(int argc, char* argv[], Options& options) {
+    options.sessions = 1000000;
+    options.threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (options.threads < 1) {
+        options.threads = 1;
+    }
+    options.seed = 1;
+    options.tickMs = 1000 / DEFAULT_TICK_RATE;
+    options.maxRounds = 100000;
+    options.csvPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            fprintf(stderr, "missing value for %s\n", arg);
+            return false;
+        }
+        i++;
+        if (strcmp(arg, "--sessions") == 0) {
+            options.sessions = static_cast<uint32_t>(strtoul(value, 0, 10));
+        } else if (strcmp(arg, "--threads") == 0) {
+            options.threads = atoi(value);
+        } else if (strcmp(arg, "--seed") == 0) {
+            options.seed = strtoull(value, 0, 10);
+        } else if (strcmp(arg, "--reaction-median") == 0) {
+            options.bot.reactionMedianMs = atof(value);
+        } else if (strcmp(arg, "--reaction-sigma") == 0) {
+            options.bot.reactionSigma = atof(value);
+        } else if (strcmp(arg, "--error-rate") == 0) {
+            options.bot.errorRate = atof(value);
+        } else if (strcmp(arg, "--tick-rate") == 0) {
+            int rate = atoi(value);
+            // ティック長は整数ミリ秒なので 1000 を割り切れるレートのみ
+            options.tickMs =
+                rate > 0 && rate <= 1000 && 1000 % rate == 0 ? 1000 / rate : 0;
+        } else if (strcmp(arg, "--max-rounds") == 0) {
+            options.maxRounds = atoi(value);
+        } else if (strcmp(arg, "--csv") == 0) {
+            options.csvPath = value;
+        } else {
+            fprintf(stderr, "unknown option: %s\n", arg);
+            return false;
+        }
+    }
+
+    if (options.tickMs == 0) {
+        fprintf(stderr, "invalid tick rate (must divide 1000)\n");
+        return false;
+    }
+    return true;
+}
+
+static void writeCsv(const char* path, const Accumulator& total) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "failed to open %s\n", path);
+        return;
+    }
+    fprintf(file, "score,sessions\n");
+    for (int i = 0; i < SCORE_BUCKETS; i++) {
+        if (total.scoreHistogram[i]) {
+            fprintf(file, "%d,%llu\n", i,
+                    static_cast<unsigned long long>(total.scoreHistogram[i]));
+        }
+    }
+    fprintf(file, "\ngameover_second,sessions\n");
+    for (int i = 0; i < DEATH_BUCKETS; i++) {
+        if (total.deathHistogram[i]) {
+            fprintf(file, "%d,%llu\n", i,
+                    static_cast<unsigned long long>(total.deathHistogram[i]));
+        }
+    }
+    fclose(file);
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    std::vector<Accumulator> accumulators(options.threads);
+
+    std::chrono::steady_clock::time_point begin =
+        std::chrono::steady_clock::now();
+
+    WorkStealingPool::run(
+        options.sessions, options.threads, SESSION_CHUNK,
+        [&](int worker, uint32_t first, uint32_t last) {
+            Accumulator& acc = accumulators[worker];
+            for (uint32_t i = first; i < last; i++) {
+                uint64_t seed = sessionSeed(options.seed, i);
+                SimState state;
+                state.rng.seed(seed);
+                BotPlayer bot(options.bot, ~seed);
+                DeathCause cause = runSession(state, bot, options);
+                record(acc, state, cause);
+            }
+        });
+
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - begin)
+                         .count();
+
+    // スレッドごとの集計をまとめる
+    Accumulator total;
+    for (size_t i = 0; i < accumulators.size(); i++) {
+        total.merge(accumulators[i]);
+    }
+
+    uint64_t n = total.sessions;
+    printf("sessions        : %llu (%d threads)\n",
+           static_cast<unsigned long long>(n), options.threads);
+    printf("elapsed         : %.3f s (%.0f sessions/min)\n", seconds,
+           seconds > 0 ? n / seconds * 60.0 : 0.0);
+    printf("bot             : reaction median %.0f ms, sigma %.2f, "
+           "error rate %.3f\n",
+           options.bot.reactionMedianMs, options.bot.reactionSigma,
+           options.bot.errorRate);
+    if (n == 0) {
+        return 0;
+    }
+    printf("average score   : %.3f\n",
+           static_cast<double>(total.rounds - n) / n);
+    printf("score p50/p90/p99 : %d / %d / %d\n",
+           histogramPercentile(total.scoreHistogram, SCORE_BUCKETS, n, 0.50),
+           histogramPercentile(total.scoreHistogram, SCORE_BUCKETS, n, 0.90),
+           histogramPercentile(total.scoreHistogram, SCORE_BUCKETS, n, 0.99));
+    printf("gameover s p50/p90/p99 : %d / %d / %d\n",
+           histogramPercentile(total.deathHistogram, DEATH_BUCKETS, n, 0.50),
+           histogramPercentile(total.deathHistogram, DEATH_BUCKETS, n, 0.90),
+           histogramPercentile(total.deathHistogram, DEATH_BUCKETS, n, 0.99));
+    printf("cause timeout/wrong/capped : %.2f%% / %.2f%% / %.2f%%\n",
+           100.0 * total.causes[DEATH_TIMEOUT] / n,
+           100.0 * total.causes[DEATH_WRONG_WALL] / n,
+           100.0 * total.causes[DEATH_CAPPED] / n);
+
+    if (options.csvPath) {
+        writeCsv(options.csvPath, total);
+    }
+
+    return 0;
+}